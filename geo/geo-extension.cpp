@@ -15,6 +15,7 @@
 #include "measure-functions.hpp"
 #include "parser-functions.hpp"
 #include "predicate-functions.hpp"
+#include "spatial-join.hpp"
 #include "transformation-functions.hpp"
 
 namespace duckdb {
@@ -33,12 +34,31 @@ void GeoExtension::Load(DuckDB &db) {
 	info.internal = true;
 	catalog.CreateType(*con.context, &info);
 
+	// point-only columns can be stored unpacked, so DuckDB compresses the coordinates as plain doubles
+	child_list_t<LogicalType> point_children {{"x", LogicalType::DOUBLE}, {"y", LogicalType::DOUBLE}};
+	auto point_type = LogicalType::STRUCT(move(point_children));
+	point_type.SetAlias("GEOGRAPHY_POINT");
+
+	CreateTypeInfo point_info("Geography_Point", point_type);
+	point_info.temporary = true;
+	point_info.internal = true;
+	catalog.CreateType(*con.context, &point_info);
+
 	// add geo casts
 	auto &config = DBConfig::GetConfig(*con.context);
 
 	auto &casts = config.GetCastFunctions();
 	casts.RegisterCastFunction(LogicalType::VARCHAR, geo_type, GeoFunctions::CastVarcharToGEO, 100);
 	casts.RegisterCastFunction(geo_type, LogicalType::VARCHAR, GeoFunctions::CastGeoToVarchar);
+	// packing drops the SRID and rejects non-points, so mixed calls bind to the GEOGRAPHY overloads, as do text and
+	// NULL literals
+	casts.RegisterCastFunction(point_type, geo_type, GeoFunctions::CastPointToGEO, 1);
+	casts.RegisterCastFunction(geo_type, point_type, GeoFunctions::CastGeoToPoint, 200);
+	casts.RegisterCastFunction(LogicalType::VARCHAR, point_type, GeoFunctions::CastVarcharToPoint, 300);
+	casts.RegisterCastFunction(LogicalType::SQLNULL, point_type, GeoFunctions::CastNullToPoint, 300);
+
+	// plan joins on spatial predicates as STR-tree spatial joins
+	config.optimizer_extensions.push_back(SpatialJoinOptimizer::GetOptimizerExtension());
 
 	// add geo functions
 	std::vector<ScalarFunctionSet> geo_function_set {};
@@ -55,13 +75,13 @@ void GeoExtension::Load(DuckDB &db) {
 	auto transformation_func_set = GetTransformationScalarFunctions(geo_type);
 	geo_function_set.insert(geo_function_set.end(), transformation_func_set.begin(), transformation_func_set.end());
 	//  **Accessors (15)**
-	auto accessor_func_set = GetAccessorScalarFunctions(geo_type);
+	auto accessor_func_set = GetAccessorScalarFunctions(geo_type, point_type);
 	geo_function_set.insert(geo_function_set.end(), accessor_func_set.begin(), accessor_func_set.end());
 	// **Predicates (9)**
-	auto predicate_func_set = GetPredicateScalarFunctions(geo_type);
+	auto predicate_func_set = GetPredicateScalarFunctions(geo_type, point_type);
 	geo_function_set.insert(geo_function_set.end(), predicate_func_set.begin(), predicate_func_set.end());
 	// **Measures (9)**
-	auto measure_func_set = GetMeasureScalarFunctions(geo_type);
+	auto measure_func_set = GetMeasureScalarFunctions(geo_type, point_type);
 	geo_function_set.insert(geo_function_set.end(), measure_func_set.begin(), measure_func_set.end());
 
 	for (auto func_set : geo_function_set) {
@@ -73,6 +93,14 @@ void GeoExtension::Load(DuckDB &db) {
 	CreateAggregateFunctionInfo cluster_db_scan_func_info(move(cluster_db_scan));
 	catalog.CreateFunction(*con.context, &cluster_db_scan_func_info);
 
+	auto extent_agg = GetExtentAggAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo extent_agg_func_info(move(extent_agg));
+	catalog.CreateFunction(*con.context, &extent_agg_func_info);
+
+	auto union_agg = GetUnionAggAggregateFunction(geo_type);
+	CreateAggregateFunctionInfo union_agg_func_info(move(union_agg));
+	catalog.CreateFunction(*con.context, &union_agg_func_info);
+
 	con.Commit();
 }
 
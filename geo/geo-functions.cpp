@@ -2,51 +2,91 @@
 
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/common/vector_operations/generic_executor.hpp"
+#include "duckdb/execution/expression_executor_state.hpp"
+#include "geohash.hpp"
+#include "geojson-reader.hpp"
 #include "geometry.hpp"
-
-#include <unistd.h>
+#include "space-filling-curve.hpp"
+#include "wkb-text-writer.hpp"
+#include "wkb-validator.hpp"
+#include "wkb-view.hpp"
+#include "wkt-reader.hpp"
 
 namespace duckdb {
-int loopindex = 1;
-std::vector<int> queue {};
 
-bool GeoFunctions::CastVarcharToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
-	int currindex = loopindex;
-	queue.push_back(currindex);
-	loopindex++;
-	while (queue.size() > 0 && queue[0] != currindex) {
-		usleep(30);
+//! Write the EWKB of the geometry last read by reader straight into the string heap of result
+template <class READER>
+static string_t WriteReaderWKB(READER &reader, Vector &result) {
+	auto wkb = StringVector::EmptyString(result, reader.GetWKBSize());
+	reader.WriteWKB((data_ptr_t)wkb.GetDataWriteable());
+	wkb.Finalize();
+	return wkb;
+}
+
+//! Read text with the reader matching the format LWGEOM_in picks: GeoJSON when it starts with '{', WKT otherwise.
+//! Returns false when the text has to go through Geometry::ToGserialized (hex WKB, curves, or text the readers leave to
+//! liblwgeom and its errors).
+static bool TryReadText(WKTReader &wkt_reader, GeoJSONReader &geojson_reader, string_t text, Vector &result,
+                        string_t &wkb) {
+	auto data = text.GetDataUnsafe();
+	auto size = text.GetSize();
+	if (size > 0 && data[0] == '{') {
+		/* LWGEOM_in does not give GeoJSON an SRID */
+		if (!geojson_reader.TryRead(data, size, SRID_UNKNOWN)) {
+			return false;
+		}
+		wkb = WriteReaderWKB(geojson_reader, result);
+		return true;
+	}
+	if (!wkt_reader.TryRead(data, size)) {
+		return false;
 	}
+	wkb = WriteReaderWKB(wkt_reader, result);
+	return true;
+}
+
+bool GeoFunctions::CastVarcharToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
 	bool success = true;
+	WKTReader wkt_reader;
+	GeoJSONReader geojson_reader;
 	try {
 		UnaryExecutor::ExecuteWithNulls<string_t, string_t>(
 		    source, result, count, [&](string_t input, ValidityMask &mask, idx_t idx) {
 			    if (input.GetSize() == 0) {
 				    return string_t();
 			    }
+			    string_t wkb;
+			    if (TryReadText(wkt_reader, geojson_reader, input, result, wkb)) {
+				    return wkb;
+			    }
 			    auto gser = Geometry::ToGserialized(input);
 			    if (!gser) {
 				    throw ConversionException("Failure in geometry cast: could not cast geometry from varchar");
 				    success = false;
 				    return string_t();
 			    }
-			    idx_t size = Geometry::GetGeometrySize(gser);
-			    auto base = Geometry::GetBase(gser);
+			    auto result_str = Geometry::ToGeometry(gser, result);
 			    Geometry::DestroyGeometry(gser);
-			    return string_t((const char *)base, size);
+			    return result_str;
 		    });
 	} catch (const std::exception &e) {
-		queue.erase(queue.begin());
 		throw Exception(e.what());
 		return false;
 	}
-	queue.erase(queue.begin());
 	return success;
 }
 
 bool GeoFunctions::CastGeoToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
 	GenericExecutor::ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
 	    source, result, count, [&](PrimitiveType<string_t> input) {
+		    /* Canonical EWKB is hex-encoded straight into the result, anything else goes through LWGEOM */
+		    WKBView view(input.val);
+		    if (WKBTextWriter::CanWriteHexWKB(view)) {
+			    auto text = StringVector::EmptyString(result, 2 * view.GetSize());
+			    WKBTextWriter::WriteHexWKB(view, text.GetDataWriteable());
+			    text.Finalize();
+			    return text;
+		    }
 		    // auto text = Geometry::GetString(input.val, DataFormatType::FORMAT_VALUE_TYPE_GEOJSON);
 		    auto text = Geometry::GetString(input.val);
 		    return StringVector::AddString(result, text);
@@ -54,37 +94,41 @@ bool GeoFunctions::CastGeoToVarchar(Vector &source, Vector &result, idx_t count,
 	return true;
 }
 
+//! ST_MakePoint writes the EWKB straight into the string heap of the result, without building an LWPOINT
 struct MakePointBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA point_x, TB point_y) {
-		auto gser = Geometry::MakePoint(point_x, point_y);
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+	static inline TR Operation(TA point_x, TB point_y, Vector &result) {
+		auto result_str = StringVector::EmptyString(result, GEOGRAPHY_POINT_SIZE);
+		WKBView::WritePoint(point_x, point_y, (data_ptr_t)result_str.GetDataWriteable());
+		result_str.Finalize();
+		return result_str;
 	}
 };
 
 struct MakePointTernaryOperator {
 	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA point_x, TB point_y, TC point_z) {
-		auto gser = Geometry::MakePoint(point_x, point_y, point_z);
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+	static inline TR Operation(TA point_x, TB point_y, TC point_z, Vector &result) {
+		auto result_str = StringVector::EmptyString(result, GEOGRAPHY_POINTZ_SIZE);
+		WKBView::WritePoint(point_x, point_y, point_z, (data_ptr_t)result_str.GetDataWriteable());
+		result_str.Finalize();
+		return result_str;
 	}
 };
 
 template <typename TA, typename TB, typename TR>
-static void MakePointBinaryExecutor(Vector &point_x, Vector &point_y, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, MakePointBinaryOperator>(point_x, point_y, result, count);
+static void MakePointBinaryExecutor(Vector &point_x_vec, Vector &point_y_vec, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(point_x_vec, point_y_vec, result, count, [&](TA point_x, TB point_y) {
+		return MakePointBinaryOperator::Operation<TA, TB, TR>(point_x, point_y, result);
+	});
 }
 
 template <typename TA, typename TB, typename TC, typename TR>
-static void MakePointTernaryExecutor(Vector &point_x, Vector &point_y, Vector &point_z, Vector &result, idx_t count) {
-	TernaryExecutor::Execute<TA, TB, TC, TR>(point_x, point_y, point_z, result, count,
-	                                         MakePointTernaryOperator::Operation<TA, TB, TC, TR>);
+static void MakePointTernaryExecutor(Vector &point_x_vec, Vector &point_y_vec, Vector &point_z_vec, Vector &result,
+                                     idx_t count) {
+	TernaryExecutor::Execute<TA, TB, TC, TR>(
+	    point_x_vec, point_y_vec, point_z_vec, result, count, [&](TA point_x, TB point_y, TC point_z) {
+		    return MakePointTernaryOperator::Operation<TA, TB, TC, TR>(point_x, point_y, point_z, result);
+	    });
 }
 
 void GeoFunctions::MakePointFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -101,7 +145,7 @@ void GeoFunctions::MakePointFunction(DataChunk &args, ExpressionState &state, Ve
 
 struct MakeLineBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA point1, TB point2) {
+	static inline TR Operation(TA point1, TB point2, Vector &result) {
 		if (point1.GetSize() == 0 || point2.GetSize() == 0) {
 			return string_t();
 		}
@@ -123,18 +167,19 @@ struct MakeLineBinaryOperator {
 			Geometry::DestroyGeometry(gser2);
 			return string_t();
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser1);
 		Geometry::DestroyGeometry(gser2);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, rv_size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TB, typename TR>
-static void MakeLineBinaryExecutor(Vector &point1, Vector &point2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, MakeLineBinaryOperator>(point1, point2, result, count);
+static void MakeLineBinaryExecutor(Vector &point1_vec, Vector &point2_vec, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(point1_vec, point2_vec, result, count, [&](TA point1, TB point2) {
+		return MakeLineBinaryOperator::Operation<TA, TB, TR>(point1, point2, result);
+	});
 }
 
 void GeoFunctions::MakeLineFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -196,19 +241,17 @@ void GeoFunctions::MakeLineArrayFunction(DataChunk &args, ExpressionState &state
 			gserArray[child_idx] = gser;
 		}
 		auto gserline = Geometry::MakeLineGArray(&gserArray[0], list_entry.length);
-		idx_t rv_size = Geometry::GetGeometrySize(gserline);
-		auto base = Geometry::GetBase(gserline);
+		result_entries[i] = Geometry::ToGeometry(gserline, result);
 		for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 			Geometry::DestroyGeometry(gserArray[child_idx]);
 		}
 		Geometry::DestroyGeometry(gserline);
-		result_entries[i] = string_t((const char *)base, rv_size);
 	}
 }
 
 struct MakePolygonUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			// throw ConversionException(
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
@@ -216,17 +259,16 @@ struct MakePolygonUnaryOperator {
 		}
 		auto gser = Geometry::GetGserialized(geom);
 		auto gserpoly = Geometry::MakePolygon(gser);
-		idx_t rv_size = Geometry::GetGeometrySize(gserpoly);
-		auto base = Geometry::GetBase(gserpoly);
+		auto result_str = Geometry::ToGeometry(gserpoly, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserpoly);
-		return string_t((const char *)base, rv_size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void MakePolygonUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, MakePolygonUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, MakePolygonUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::MakePolygonFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -298,14 +340,12 @@ void GeoFunctions::MakePolygonFunction(DataChunk &args, ExpressionState &state,
 				result_entries[i] = string_t();
 				continue;
 			}
-			idx_t rv_size = Geometry::GetGeometrySize(gserpoly);
-			auto base = Geometry::GetBase(gserpoly);
+			result_entries[i] = Geometry::ToGeometry(gserpoly, result);
 			for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 				Geometry::DestroyGeometry(gserArray[child_idx]);
 			}
 			Geometry::DestroyGeometry(gserpoly);
 			Geometry::DestroyGeometry(gser);
-			result_entries[i] = string_t((const char *)base, rv_size);
 		}
 		// MakePolygonBinaryExecutor<string_t, string_t>(point1_arg, result, args.size());
 	} else {
@@ -366,26 +406,14 @@ void GeoFunctions::GeometryAsBinaryFunction(DataChunk &args, ExpressionState &st
 	}
 }
 
-struct AsTextUnaryOperator {
-	template <class TA, class TR>
-	static inline TR Operation(TA geom, Vector &result) {
-		if (geom.GetSize() == 0) {
-			return geom;
-		}
-		auto gser = Geometry::GetGserialized(geom);
-		auto text = Geometry::AsText(gser);
-		auto result_str = StringVector::EmptyString(result, text.size());
-		memcpy(result_str.GetDataWriteable(), text.c_str(), text.size());
-		result_str.Finalize();
-		Geometry::DestroyGeometry(gser);
-		return result_str;
-	}
-};
-
-static string_t AsTextScalarFunction(Vector &result, string_t geom, size_t max_digits) {
+//! Format geom as ISO WKT with the writer, and through LWGEOM for the types the writer leaves out
+static string_t AsTextScalarFunction(WKBTextWriter &writer, Vector &result, string_t geom, int max_digits) {
 	if (geom.GetSize() == 0) {
 		return geom;
 	}
+	if (writer.TryWriteWKT(WKBView(geom), max_digits)) {
+		return StringVector::AddString(result, writer.GetData(), writer.GetSize());
+	}
 	auto gser = Geometry::GetGserialized(geom);
 	auto str = Geometry::AsText(gser, max_digits);
 	auto result_str = StringVector::EmptyString(result, str.size());
@@ -397,13 +425,17 @@ static string_t AsTextScalarFunction(Vector &result, string_t geom, size_t max_d
 
 template <typename TA, typename TR>
 static void GeometryAsTextUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::ExecuteString<TA, TR, AsTextUnaryOperator>(geom, result, count);
+	WKBTextWriter writer;
+	UnaryExecutor::Execute<TA, TR>(geom, result, count, [&](TA value) {
+		return AsTextScalarFunction(writer, result, value, OUT_DEFAULT_DECIMAL_DIGITS);
+	});
 }
 
 template <typename TA, typename TB, typename TR>
 static void GeometryAsTextBinaryExecutor(Vector &text, Vector &max_digits, Vector &result, idx_t count) {
+	WKBTextWriter writer;
 	BinaryExecutor::Execute<TA, TB, TR>(text, max_digits, result, count, [&](TA value, TB m_digits) {
-		return AsTextScalarFunction(result, value, m_digits);
+		return AsTextScalarFunction(writer, result, value, m_digits);
 	});
 }
 
@@ -417,47 +449,39 @@ void GeoFunctions::GeometryAsTextFunction(DataChunk &args, ExpressionState &stat
 	}
 }
 
-struct AsGeojsonUnaryOperator {
-	template <class TA, class TR>
-	static inline TR Operation(TA geom, Vector &result) {
-		if (geom.GetSize() == 0) {
-			return geom;
-		}
-		auto gser = Geometry::GetGserialized(geom);
-		auto geojson = Geometry::AsGeoJson(gser);
-		std::string geoText = std::string(geojson->data);
-		auto result_str = StringVector::EmptyString(result, geoText.size());
-		memcpy(result_str.GetDataWriteable(), geoText.c_str(), geoText.size());
-		result_str.Finalize();
-		return result_str;
+//! Format geom as GeoJSON with the writer, and through LWGEOM for the types the writer leaves out
+static string_t AsGeojsonScalarFunction(WKBTextWriter &writer, Vector &result, string_t geom, int m_dec_digits) {
+	if (geom.GetSize() == 0) {
+		return string_t();
 	}
-};
-
-struct AsGeojsonBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom, TB m_dec_digits) {
-		if (geom.GetSize() == 0) {
-			return string_t();
-		}
-		auto gser = Geometry::GetGserialized(geom);
-		if (!gser) {
-			throw ConversionException("Failure in geometry asgeojson");
-		}
-		auto geojson = Geometry::AsGeoJson(gser, m_dec_digits);
-		std::string geoText = std::string(geojson->data);
-		Geometry::DestroyGeometry(gser);
-		return string_t(geoText.c_str(), geoText.size());
+	if (writer.TryWriteGeoJSON(WKBView(geom), m_dec_digits)) {
+		return StringVector::AddString(result, writer.GetData(), writer.GetSize());
 	}
-};
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException("Failure in geometry asgeojson");
+	}
+	auto geojson = Geometry::AsGeoJson(gser, m_dec_digits);
+	Geometry::DestroyGeometry(gser);
+	auto result_str = StringVector::AddString(result, geojson->data, LWSIZE_GET(geojson->size) - LWVARHDRSZ);
+	lwfree(geojson);
+	return result_str;
+}
 
 template <typename TA, typename TR>
-static void GeometryAsGeojsonUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::ExecuteString<TA, TR, AsGeojsonUnaryOperator>(text, result, count);
+static void GeometryAsGeojsonUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
+	WKBTextWriter writer;
+	UnaryExecutor::Execute<TA, TR>(geom, result, count, [&](TA value) {
+		return AsGeojsonScalarFunction(writer, result, value, OUT_DEFAULT_DECIMAL_DIGITS);
+	});
 }
 
 template <typename TA, typename TB, typename TR>
 static void GeometryAsGeojsonBinaryExecutor(Vector &geom, Vector &m_dec_digits, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, AsGeojsonBinaryOperator>(geom, m_dec_digits, result, count);
+	WKBTextWriter writer;
+	BinaryExecutor::Execute<TA, TB, TR>(geom, m_dec_digits, result, count, [&](TA value, TB digits) {
+		return AsGeojsonScalarFunction(writer, result, value, digits);
+	});
 }
 
 void GeoFunctions::GeometryAsGeojsonFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -470,12 +494,43 @@ void GeoFunctions::GeometryAsGeojsonFunction(DataChunk &args, ExpressionState &s
 	}
 }
 
+//! ST_GEOHASH straight from the bounding box of the WKB, without building a GSERIALIZED. Returns false for the values
+//! left to lwgeom_geohash: curves, and boxes outside the GeoHash range, whose error it raises.
+static bool TryWriteGeoHash(string_t geom, int precision, Vector &result, string_t &hash) {
+	WKBView view(geom);
+	GBOX box;
+	if (!view.TryGetBBox(box)) {
+		return false;
+	}
+	if (box.xmin > box.xmax) {
+		// an empty geometry has no GeoHash
+		hash = string_t();
+		return true;
+	}
+	if (!GeoHash::IsInRange(box)) {
+		return false;
+	}
+	double lon, lat;
+	GeoHash::BoxCenter(box, lon, lat);
+	if (precision <= 0) {
+		precision = GeoHash::BoxPrecision(box);
+	}
+	hash = StringVector::EmptyString(result, precision);
+	GeoHash::WriteText(lon, lat, precision, hash.GetDataWriteable());
+	hash.Finalize();
+	return true;
+}
+
 struct GeoHashUnaryOperator {
 	template <class TA, class TR>
 	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
+		string_t hash;
+		if (TryWriteGeoHash(geom, 0, result, hash)) {
+			return hash;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry geohash");
@@ -499,6 +554,10 @@ static TR GeoHashScalarFunction(Vector &result, TA geom, TB m_chars) {
 	if (geom.GetSize() == 0) {
 		return geom;
 	}
+	string_t hash;
+	if (TryWriteGeoHash(geom, m_chars, result, hash)) {
+		return hash;
+	}
 	auto gser = Geometry::GetGserialized(geom);
 	if (!gser) {
 		throw ConversionException("Failure in geometry geohash");
@@ -538,6 +597,171 @@ void GeoFunctions::GeometryGeoHashFunction(DataChunk &args, ExpressionState &sta
 	}
 }
 
+//! The 2D bounding box of geom, read from the WKB unless the geometry holds curves. Returns false for an empty
+//! geometry. error is the message of the calling function, raised when the geometry cannot be read.
+static bool GetGeometryBBox(string_t geom, GBOX &box, const char *error) {
+	WKBView view(geom);
+	if (view.TryGetBBox(box)) {
+		return !(box.xmin > box.xmax);
+	}
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException(error);
+	}
+	auto has_box = Geometry::GeometryBBox(gser, box);
+	Geometry::DestroyGeometry(gser);
+	return has_box;
+}
+
+void GeoFunctions::GeometryGeoHashIntFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto count = args.size();
+	auto &geom_arg = args.data[0];
+	UnifiedVectorFormat geom_data;
+	UnifiedVectorFormat bits_data;
+	geom_arg.ToUnifiedFormat(count, geom_data);
+	if (args.data.size() == 2) {
+		args.data[1].ToUnifiedFormat(count, bits_data);
+	}
+	auto geoms = (string_t *)geom_data.data;
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<uint64_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	// the centers of the whole chunk are gathered into coordinate columns and hashed in one batch
+	vector<double> lon(count), lat(count);
+	vector<idx_t> rows(count);
+	vector<uint8_t> shifts(count);
+	idx_t npoints = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = geom_data.sel->get_index(i);
+		if (!geom_data.validity.RowIsValid(idx)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		int32_t bits = 64;
+		if (args.data.size() == 2) {
+			auto bits_idx = bits_data.sel->get_index(i);
+			if (!bits_data.validity.RowIsValid(bits_idx)) {
+				result_validity.SetInvalid(i);
+				continue;
+			}
+			bits = ((int32_t *)bits_data.data)[bits_idx];
+			if (bits < 1 || bits > 64) {
+				throw ConversionException("Failure in geometry geohash: the number of bits must be between 1 and 64");
+			}
+		}
+		auto geom = geoms[idx];
+		GBOX box;
+		if (geom.GetSize() == 0 || !GetGeometryBBox(geom, box, "Failure in geometry geohash")) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		if (!GeoHash::IsInRange(box)) {
+			throw ConversionException("Failure in geometry geohash: Geohash requires inputs in decimal degrees");
+		}
+		GeoHash::BoxCenter(box, lon[npoints], lat[npoints]);
+		shifts[npoints] = 64 - bits;
+		rows[npoints] = i;
+		npoints++;
+	}
+
+	vector<uint64_t> hashes(npoints);
+	GeoHash::Encode(lon.data(), lat.data(), npoints, hashes.data());
+	for (idx_t i = 0; i < npoints; i++) {
+		result_data[rows[i]] = hashes[i] >> shifts[i];
+	}
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+//! Compute the ST_HILBERT or ST_ZORDER keys of a chunk. The bounding box centers are mapped to grid cells, scaled to
+//! the bounding box of the extent argument when there is one, and the keys of the whole chunk are computed in one
+//! batch.
+static void ExecuteSpaceFillingCurve(DataChunk &args, Vector &result,
+                                     void (*curve)(const uint32_t *, const uint32_t *, idx_t, uint64_t *),
+                                     const char *error) {
+	auto count = args.size();
+	bool has_extent = args.data.size() == 2;
+	UnifiedVectorFormat geom_data;
+	UnifiedVectorFormat extent_data;
+	args.data[0].ToUnifiedFormat(count, geom_data);
+	if (has_extent) {
+		args.data[1].ToUnifiedFormat(count, extent_data);
+	}
+	auto geoms = (string_t *)geom_data.data;
+	auto extents = (string_t *)extent_data.data;
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<uint64_t>(result);
+	auto &result_validity = FlatVector::Validity(result);
+
+	vector<uint32_t> x(count), y(count);
+	vector<idx_t> rows(count);
+	idx_t ncells = 0;
+	// the extent is usually a constant, so its box is only read again when the row points to another value
+	GBOX extent_box;
+	bool has_extent_box = false;
+	idx_t extent_box_idx = DConstants::INVALID_INDEX;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = geom_data.sel->get_index(i);
+		if (!geom_data.validity.RowIsValid(idx)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		auto geom = geoms[idx];
+		GBOX box;
+		if (geom.GetSize() == 0 || !GetGeometryBBox(geom, box, error)) {
+			result_validity.SetInvalid(i);
+			continue;
+		}
+		double center_x = box.xmin + (box.xmax - box.xmin) / 2;
+		double center_y = box.ymin + (box.ymax - box.ymin) / 2;
+		if (!has_extent) {
+			x[ncells] = SpaceFillingCurve::OrderedBits(center_x);
+			y[ncells] = SpaceFillingCurve::OrderedBits(center_y);
+		} else {
+			auto extent_idx = extent_data.sel->get_index(i);
+			if (!extent_data.validity.RowIsValid(extent_idx)) {
+				result_validity.SetInvalid(i);
+				continue;
+			}
+			if (extent_idx != extent_box_idx) {
+				auto extent = extents[extent_idx];
+				has_extent_box = extent.GetSize() > 0 && GetGeometryBBox(extent, extent_box, error);
+				extent_box_idx = extent_idx;
+			}
+			// an empty extent gives no grid to place the geometry on
+			if (!has_extent_box) {
+				result_validity.SetInvalid(i);
+				continue;
+			}
+			x[ncells] = SpaceFillingCurve::Scale(center_x, extent_box.xmin, extent_box.xmax);
+			y[ncells] = SpaceFillingCurve::Scale(center_y, extent_box.ymin, extent_box.ymax);
+		}
+		rows[ncells] = i;
+		ncells++;
+	}
+
+	vector<uint64_t> keys(ncells);
+	curve(x.data(), y.data(), ncells, keys.data());
+	for (idx_t i = 0; i < ncells; i++) {
+		result_data[rows[i]] = keys[i];
+	}
+	if (args.AllConstant()) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+void GeoFunctions::GeometryHilbertFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteSpaceFillingCurve(args, result, SpaceFillingCurve::Hilbert, "Failure in geometry hilbert");
+}
+
+void GeoFunctions::GeometryZOrderFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecuteSpaceFillingCurve(args, result, SpaceFillingCurve::ZOrder, "Failure in geometry zorder");
+}
+
 struct GeogFromUnaryOperator {
 	template <class TA, class TR>
 	static inline TR Operation(TA text, Vector &result) {
@@ -549,11 +773,7 @@ struct GeogFromUnaryOperator {
 			throw ConversionException("Failure in geometry parser!");
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		auto result_str = StringVector::EmptyString(result, size);
-		memcpy(result_str.GetDataWriteable(), base, size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
 		return result_str;
 	}
@@ -561,7 +781,15 @@ struct GeogFromUnaryOperator {
 
 template <typename TA, typename TR>
 static void GeometryGeogFromUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::ExecuteString<TA, TR, GeogFromUnaryOperator>(text, result, count);
+	WKTReader wkt_reader;
+	GeoJSONReader geojson_reader;
+	UnaryExecutor::Execute<TA, TR>(text, result, count, [&](TA input) {
+		TR wkb;
+		if (TryReadText(wkt_reader, geojson_reader, input, result, wkb)) {
+			return wkb;
+		}
+		return GeogFromUnaryOperator::Operation<TA, TR>(input, result);
+	});
 }
 
 void GeoFunctions::GeometryGeogFromFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -579,11 +807,7 @@ struct GeomFromGeoJsonUnaryOperator {
 		if (!gser) {
 			throw ConversionException("Failure in geometry from Json: could not convert JSON to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		auto result_str = StringVector::EmptyString(result, size);
-		memcpy(result_str.GetDataWriteable(), base, size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
 		return result_str;
 	}
@@ -591,7 +815,14 @@ struct GeomFromGeoJsonUnaryOperator {
 
 template <typename TA, typename TR>
 static void GeometryGeomFromGeoJsonUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::ExecuteString<TA, TR, GeomFromGeoJsonUnaryOperator>(text, result, count);
+	GeoJSONReader reader;
+	UnaryExecutor::Execute<TA, TR>(text, result, count, [&](TA input) {
+		/* geom_from_geojson gives every geometry the WGS84 SRID */
+		if (reader.TryRead(input.GetDataUnsafe(), input.GetSize(), WGS84_SRID)) {
+			return WriteReaderWKB(reader, result);
+		}
+		return GeomFromGeoJsonUnaryOperator::Operation<TA, TR>(input, result);
+	});
 }
 
 void GeoFunctions::GeometryGeomFromGeoJsonFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -599,9 +830,9 @@ void GeoFunctions::GeometryGeomFromGeoJsonFunction(DataChunk &args, ExpressionSt
 	GeometryGeomFromGeoJsonUnaryExecutor<string_t, string_t>(text_arg, result, args.size());
 }
 
-struct GeometryDistanceBinaryOperator {
-	template <class TA, class TB, class TR>
-	static inline TR Operation(TA geom1, TB geom2) {
+struct GeometryDistanceTernaryOperator {
+	template <class TA, class TB, class TC, class TR>
+	static inline TR Operation(TA geom1, TB geom2, TC use_spheroid) {
 		double dis = 0.00;
 		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 			return dis;
@@ -618,60 +849,235 @@ struct GeometryDistanceBinaryOperator {
 			throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
 			return dis;
 		}
-		dis = Geometry::Distance(gser1, gser2, false);
+		dis = Geometry::Distance(gser1, gser2, use_spheroid);
 		Geometry::DestroyGeometry(gser1);
 		Geometry::DestroyGeometry(gser2);
 		return dis;
 	}
 };
 
-struct GeometryDistanceTernaryOperator {
-	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA geom1, TB geom2, TC use_spheroid) {
-		double dis = 0.00;
-		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
-			return dis;
+//! Whether both values hold exactly the same bytes
+static bool BinaryEqualsGeometry(string_t geom1, string_t geom2) {
+	return geom1.GetSize() == geom2.GetSize() &&
+	       (geom1.GetDataUnsafe() == geom2.GetDataUnsafe() ||
+	        memcmp(geom1.GetDataUnsafe(), geom2.GetDataUnsafe(), geom1.GetSize()) == 0);
+}
+
+struct CircTreeLocalState : public FunctionLocalState {
+	~CircTreeLocalState() override {
+		if (cache) {
+			Geometry::DestroyCircTree(cache);
 		}
-		auto gser1 = Geometry::GetGserialized(geom1);
-		auto gser2 = Geometry::GetGserialized(geom2);
-		if (!gser1 || !gser2) {
-			if (gser1) {
-				Geometry::DestroyGeometry(gser1);
-			}
-			if (gser2) {
-				Geometry::DestroyGeometry(gser2);
-			}
+	}
+
+	bool IsCached(string_t geom) const {
+		return cache && BinaryEqualsGeometry(string_t(cached_data.data(), cached_data.size()), geom);
+	}
+
+	//! Return the circular tree of geom, building it again only if geom is not the cached value
+	CircTreeGeomCache *GetCache(string_t geom) {
+		if (IsCached(geom)) {
+			return cache;
+		}
+		auto gser = Geometry::GetGserialized(geom);
+		if (!gser) {
 			throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
-			return dis;
 		}
-		dis = Geometry::Distance(gser1, gser2, use_spheroid);
-		Geometry::DestroyGeometry(gser1);
-		Geometry::DestroyGeometry(gser2);
-		return dis;
+		if (cache) {
+			Geometry::DestroyCircTree(cache);
+			cache = nullptr;
+		}
+		cache = Geometry::BuildCircTree(gser);
+		cached_data = geom.GetString();
+		return cache;
 	}
+
+	CircTreeGeomCache *cache = nullptr;
+	//! The bytes of the geometry the tree was built from
+	string cached_data;
+	//! The arguments of the previous row of the current chunk, an argument equal to its predecessor (a constant, or
+	//! a sorted column) gets its tree cached
+	bool has_previous = false;
+	string_t previous[2];
 };
 
-template <typename TA, typename TB, typename TR>
-static void GeometryDistanceBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, GeometryDistanceBinaryOperator>(geom1, geom2, result, count);
+unique_ptr<FunctionLocalState> GeoFunctions::InitCircTreeLocalState(ExpressionState &state,
+                                                                    const BoundFunctionExpression &expr,
+                                                                    FunctionData *bind_data) {
+	return make_unique<CircTreeLocalState>();
 }
 
-template <typename TA, typename TB, typename TC, typename TR>
-static void GeometryDistanceTernaryExecutor(Vector &geom1, Vector &geom2, Vector &use_spheroid, Vector &result,
-                                            idx_t count) {
-	TernaryExecutor::Execute<TA, TB, TC, TR>(geom1, geom2, use_spheroid, result, count,
-	                                         GeometryDistanceTernaryOperator::Operation<TA, TB, TC, TR>);
+static double CachedTreeDistance(const CircTreeGeomCache *cache, string_t geom, bool use_spheroid) {
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException("Failure in geometry get distance: could not getting distance from geom");
+	}
+	auto dis = Geometry::Distance(cache, gser, use_spheroid);
+	Geometry::DestroyGeometry(gser);
+	return dis;
+}
+
+//! The distance of a row, reusing the cached tree if one argument is the cached geometry or repeats the previous row
+static double GeometryDistanceWithCache(CircTreeLocalState &lstate, string_t geom1, string_t geom2,
+                                        bool use_spheroid) {
+	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+		return 0.00;
+	}
+	bool repeat1 = lstate.has_previous && BinaryEqualsGeometry(lstate.previous[0], geom1);
+	bool repeat2 = lstate.has_previous && BinaryEqualsGeometry(lstate.previous[1], geom2);
+	lstate.has_previous = true;
+	lstate.previous[0] = geom1;
+	lstate.previous[1] = geom2;
+	if (lstate.IsCached(geom1)) {
+		return CachedTreeDistance(lstate.cache, geom2, use_spheroid);
+	}
+	if (lstate.IsCached(geom2)) {
+		return CachedTreeDistance(lstate.cache, geom1, use_spheroid);
+	}
+	if (repeat1) {
+		return CachedTreeDistance(lstate.GetCache(geom1), geom2, use_spheroid);
+	}
+	if (repeat2) {
+		return CachedTreeDistance(lstate.GetCache(geom2), geom1, use_spheroid);
+	}
+	return GeometryDistanceTernaryOperator::Operation<string_t, string_t, bool, double>(geom1, geom2, use_spheroid);
+}
+
+//! Point to point fast path: when every row holds two POINTs, their coordinates are read straight from the WKB into
+//! coordinate columns and the distances of the whole chunk are computed in one batch, without building a GSERIALIZED
+//! or a circular tree per row. Returns false, leaving the result untouched, if any row needs the general path.
+static bool ExecutePointDistance(DataChunk &args, Vector &result) {
+	auto count = args.size();
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	if (geom1_arg.GetVectorType() == VectorType::CONSTANT_VECTOR &&
+	    geom2_arg.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		return false;
+	}
+	bool use_spheroid = false;
+	if (args.data.size() == 3) {
+		auto &use_spheroid_arg = args.data[2];
+		if (use_spheroid_arg.GetVectorType() != VectorType::CONSTANT_VECTOR ||
+		    ConstantVector::IsNull(use_spheroid_arg)) {
+			return false;
+		}
+		use_spheroid = ConstantVector::GetData<bool>(use_spheroid_arg)[0];
+	}
+
+	UnifiedVectorFormat geom1_data;
+	UnifiedVectorFormat geom2_data;
+	geom1_arg.ToUnifiedFormat(count, geom1_data);
+	geom2_arg.ToUnifiedFormat(count, geom2_data);
+	auto geoms1 = (string_t *)geom1_data.data;
+	auto geoms2 = (string_t *)geom2_data.data;
+
+	vector<double> lon1(count), lat1(count), lon2(count), lat2(count);
+	vector<idx_t> rows(count);
+	idx_t npoints = 0;
+	int32_t srid = SRID_UNKNOWN;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx1 = geom1_data.sel->get_index(i);
+		auto idx2 = geom2_data.sel->get_index(i);
+		if (!geom1_data.validity.RowIsValid(idx1) || !geom2_data.validity.RowIsValid(idx2)) {
+			continue;
+		}
+		auto geom1 = geoms1[idx1];
+		auto geom2 = geoms2[idx2];
+		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+			continue;
+		}
+		WKBView view1(geom1);
+		WKBView view2(geom2);
+		POINT4D point1;
+		POINT4D point2;
+		if (view1.GetType() != POINTTYPE || view2.GetType() != POINTTYPE || !view1.TryGetPoint(point1) ||
+		    !view2.TryGetPoint(point2)) {
+			return false;
+		}
+		// mixed SRIDs raise their error in the general path
+		if (view1.GetSRID() != view2.GetSRID() || (npoints > 0 && view1.GetSRID() != srid)) {
+			return false;
+		}
+		srid = view1.GetSRID();
+		lon1[npoints] = point1.x;
+		lat1[npoints] = point1.y;
+		lon2[npoints] = point2.x;
+		lat2[npoints] = point2.y;
+		rows[npoints] = i;
+		npoints++;
+	}
+
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<double>(result);
+	auto &result_validity = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		auto idx1 = geom1_data.sel->get_index(i);
+		auto idx2 = geom2_data.sel->get_index(i);
+		if (!geom1_data.validity.RowIsValid(idx1) || !geom2_data.validity.RowIsValid(idx2)) {
+			result_validity.SetInvalid(i);
+		} else {
+			result_data[i] = 0.00;
+		}
+	}
+	vector<double> distances(npoints);
+	Geometry::PointDistance(lon1.data(), lat1.data(), lon2.data(), lat2.data(), npoints, srid, use_spheroid,
+	                        distances.data());
+	for (idx_t i = 0; i < npoints; i++) {
+		result_data[rows[i]] = distances[i];
+	}
+	return true;
 }
 
 void GeoFunctions::GeometryDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePointDistance(args, result)) {
+		return;
+	}
+	auto &lstate = (CircTreeLocalState &)*ExecuteFunctionState::GetFunctionState(state);
+	lstate.has_previous = false;
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
+	bool first_constant = geom1_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	bool second_constant = geom2_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	bool spheroid_constant = args.data.size() == 2 || args.data[2].GetVectorType() == VectorType::CONSTANT_VECTOR;
+
+	// one constant argument: build its tree once and only compare the other argument per row
+	if (first_constant != second_constant && spheroid_constant) {
+		auto &constant_arg = first_constant ? geom1_arg : geom2_arg;
+		auto &other_arg = first_constant ? geom2_arg : geom1_arg;
+		if (ConstantVector::IsNull(constant_arg) ||
+		    (args.data.size() == 3 && ConstantVector::IsNull(args.data[2]))) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(result, true);
+			return;
+		}
+		auto constant = ConstantVector::GetData<string_t>(constant_arg)[0];
+		auto use_spheroid = args.data.size() == 3 && ConstantVector::GetData<bool>(args.data[2])[0];
+		if (constant.GetSize() == 0) {
+			UnaryExecutor::Execute<string_t, double>(other_arg, result, args.size(),
+			                                         [&](string_t geom) { return 0.00; });
+			return;
+		}
+		auto cache = lstate.GetCache(constant);
+		UnaryExecutor::Execute<string_t, double>(other_arg, result, args.size(), [&](string_t geom) {
+			if (geom.GetSize() == 0) {
+				return 0.00;
+			}
+			return CachedTreeDistance(cache, geom, use_spheroid);
+		});
+		return;
+	}
+
 	if (args.data.size() == 2) {
-		GeometryDistanceBinaryExecutor<string_t, string_t, double>(geom1_arg, geom2_arg, result, args.size());
+		BinaryExecutor::Execute<string_t, string_t, double>(
+		    geom1_arg, geom2_arg, result, args.size(),
+		    [&](string_t geom1, string_t geom2) { return GeometryDistanceWithCache(lstate, geom1, geom2, false); });
 	} else if (args.data.size() == 3) {
 		auto &use_spheroid_arg = args.data[2];
-		GeometryDistanceTernaryExecutor<string_t, string_t, bool, double>(geom1_arg, geom2_arg, use_spheroid_arg,
-		                                                                  result, args.size());
+		TernaryExecutor::Execute<string_t, string_t, bool, double>(
+		    geom1_arg, geom2_arg, use_spheroid_arg, result, args.size(),
+		    [&](string_t geom1, string_t geom2, bool use_spheroid) {
+			    return GeometryDistanceWithCache(lstate, geom1, geom2, use_spheroid);
+		    });
 	}
 }
 
@@ -695,11 +1101,7 @@ struct CentroidUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return geom;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
-		auto result_str = StringVector::EmptyString(result, rv_size);
-		memcpy(result_str.GetDataWriteable(), base, rv_size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToGeometry(gserCentroid, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserCentroid);
 		return result_str;
@@ -747,7 +1149,7 @@ void GeoFunctions::GeometryCentroidFunction(DataChunk &args, ExpressionState &st
 
 struct FromTextUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
@@ -756,16 +1158,15 @@ struct FromTextUnaryOperator {
 			throw ConversionException("Failure in geometry from text: could not convert text to geometry");
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 struct FromTextBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB srid) {
+	static inline TR Operation(TA text, TB srid, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
@@ -774,30 +1175,25 @@ struct FromTextBinaryOperator {
 			throw ConversionException("Failure in geometry from text: could not convert text to geometry");
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryFromTextUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, FromTextUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, FromTextUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
-static void GeometryFromTextBinaryExecutor(Vector &text, Vector &srid, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromTextBinaryOperator>(text, srid, result, count);
+static void GeometryFromTextBinaryExecutor(Vector &text_vec, Vector &srid_vec, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(text_vec, srid_vec, result, count, [&](TA text, TB srid) {
+		return FromTextBinaryOperator::Operation<TA, TB, TR>(text, srid, result);
+	});
 }
 
 void GeoFunctions::GeometryFromTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	int currindex = loopindex;
-	queue.push_back(currindex);
-	loopindex++;
-	while (queue.size() > 0 && queue[0] != currindex) {
-		usleep(30);
-	}
 	try {
 		auto &text_arg = args.data[0];
 		if (args.data.size() == 1) {
@@ -807,44 +1203,44 @@ void GeoFunctions::GeometryFromTextFunction(DataChunk &args, ExpressionState &st
 			GeometryFromTextBinaryExecutor<string_t, int32_t, string_t>(text_arg, srid_arg, result, args.size());
 		}
 	} catch (const std::exception &e) {
-		queue.erase(queue.begin());
 		throw Exception(e.what());
-		return;
 	}
-	queue.erase(queue.begin());
+}
+
+//! Read a WKB blob into a GEOGRAPHY value. Blobs the validator accepts are copied, or rewritten in machine byte order,
+//! straight into the result; the others go through LWGEOM_from_WKB, which reads them or raises the errors.
+static string_t GeometryFromWKB(string_t blob, int32_t srid, Vector &result) {
+	if (blob.GetSize() == 0) {
+		return blob;
+	}
+	WKBValidator validator;
+	if (validator.TryValidate((const_data_ptr_t)blob.GetDataUnsafe(), blob.GetSize(), srid)) {
+		auto result_str = StringVector::EmptyString(result, validator.GetSize());
+		validator.Write((data_ptr_t)result_str.GetDataWriteable());
+		result_str.Finalize();
+		return result_str;
+	}
+	auto gser = Geometry::FromWKB(blob.GetDataUnsafe(), blob.GetSize(), srid);
+	if (!gser) {
+		throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
+	}
+	auto result_str = Geometry::ToGeometry(gser, result);
+	Geometry::DestroyGeometry(gser);
+	return result_str;
 }
 
 struct FromWKBUnaryOperator {
 	template <class TA, class TR>
 	static inline TR Operation(TA text, ValidityMask &result_mask, idx_t i, void *dataptr) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromWKB(text.GetDataUnsafe(), text.GetSize());
-		if (!gser) {
-			throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
-		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		auto &result = *reinterpret_cast<Vector *>(dataptr);
+		return GeometryFromWKB(text, SRID_UNKNOWN, result);
 	}
 };
 
 struct FromWKBBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB srid) {
-		if (text.GetSize() == 0) {
-			return text;
-		}
-		auto gser = Geometry::FromWKB(text.GetDataUnsafe(), text.GetSize(), srid);
-		if (!gser) {
-			throw ConversionException("Failure in geometry from WKB: could not convert WKB to geometry");
-		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
-		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+	static inline TR Operation(TA text, TB srid, Vector &result) {
+		return GeometryFromWKB(text, srid, result);
 	}
 };
 
@@ -854,8 +1250,10 @@ static void GeometryFromWKBUnaryExecutor(Vector &text, Vector &result, idx_t cou
 }
 
 template <typename TA, typename TB, typename TR>
-static void GeometryFromWKBBinaryExecutor(Vector &text, Vector &srid, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromWKBBinaryOperator>(text, srid, result, count);
+static void GeometryFromWKBBinaryExecutor(Vector &text_vec, Vector &srid_vec, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(text_vec, srid_vec, result, count, [&](TA text, TB srid) {
+		return FromWKBBinaryOperator::Operation<TA, TB, TR>(text, srid, result);
+	});
 }
 
 void GeoFunctions::GeometryFromWKBFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -868,48 +1266,69 @@ void GeoFunctions::GeometryFromWKBFunction(DataChunk &args, ExpressionState &sta
 	}
 }
 
+//! ST_GEOMFROMGEOHASH straight from the decoded box: the EWKB of the geometry BOX2D_to_LWGEOM builds is written without
+//! building an LWGEOM. Returns false for a GeoHash with an invalid character, whose error liblwgeom raises.
+static bool TryWriteGeoHashEnvelope(string_t text, int precision, Vector &result, string_t &geom) {
+	GBOX box;
+	if (!GeoHash::TryDecodeBBox(text.GetDataUnsafe(), text.GetSize(), precision, box)) {
+		return false;
+	}
+	geom = StringVector::EmptyString(result, WKBView::EnvelopeSize(box));
+	WKBView::WriteEnvelope(box, (data_ptr_t)geom.GetDataWriteable());
+	geom.Finalize();
+	return true;
+}
+
 struct FromGeoHashUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
+		string_t geom;
+		if (TryWriteGeoHashEnvelope(text, -1, result, geom)) {
+			return geom;
+		}
 		auto gser = Geometry::FromGeoHash(text);
 		if (!gser) {
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 struct FromGeoHashBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB precision) {
+	static inline TR Operation(TA text, TB precision, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
+		string_t geom;
+		if (TryWriteGeoHashEnvelope(text, precision, result, geom)) {
+			return geom;
+		}
 		auto gser = Geometry::FromGeoHash(text, precision);
 		if (!gser) {
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gser);
-		auto base = Geometry::GetBase(gser);
+		auto result_str = Geometry::ToGeometry(gser, result);
 		Geometry::DestroyGeometry(gser);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryFromGeoHashUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, FromGeoHashUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, FromGeoHashUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
-static void GeometryFromGeoHashBinaryExecutor(Vector &text, Vector &precision, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, FromGeoHashBinaryOperator>(text, precision, result, count);
+static void GeometryFromGeoHashBinaryExecutor(Vector &text_vec, Vector &precision_vec, Vector &result, idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(text_vec, precision_vec, result, count, [&](TA text, TB precision) {
+		return FromGeoHashBinaryOperator::Operation<TA, TB, TR>(text, precision, result);
+	});
 }
 
 void GeoFunctions::GeometryFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -922,12 +1341,31 @@ void GeoFunctions::GeometryFromGeoHashFunction(DataChunk &args, ExpressionState
 	}
 }
 
+//! ST_POINTFROMGEOHASH straight from the decoded box: the point is the centroid of its envelope, computed as GEOS does
+//! (see GeoHash::EnvelopeCentroid). Returns false for a GeoHash with an invalid character.
+static bool TryWriteGeoHashCentroid(string_t text, int precision, Vector &result, string_t &geom) {
+	GBOX box;
+	if (!GeoHash::TryDecodeBBox(text.GetDataUnsafe(), text.GetSize(), precision, box)) {
+		return false;
+	}
+	double x, y;
+	GeoHash::EnvelopeCentroid(box, x, y);
+	geom = StringVector::EmptyString(result, GEOGRAPHY_POINT_SIZE);
+	WKBView::WritePoint(x, y, (data_ptr_t)geom.GetDataWriteable());
+	geom.Finalize();
+	return true;
+}
+
 struct GPointFromGeoHashUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA text) {
+	static inline TR Operation(TA text, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
+		string_t geom;
+		if (TryWriteGeoHashCentroid(text, -1, result, geom)) {
+			return geom;
+		}
 		auto gser = Geometry::FromGeoHash(text);
 		if (!gser) {
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
@@ -937,20 +1375,23 @@ struct GPointFromGeoHashUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
+		auto result_str = Geometry::ToGeometry(gserCentroid, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserCentroid);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 struct GPointFromGeoHashBinaryOperator {
 	template <class TA, class TB, class TR>
-	static inline TR Operation(TA text, TB precision) {
+	static inline TR Operation(TA text, TB precision, Vector &result) {
 		if (text.GetSize() == 0) {
 			return text;
 		}
+		string_t geom;
+		if (TryWriteGeoHashCentroid(text, precision, result, geom)) {
+			return geom;
+		}
 		auto gser = Geometry::FromGeoHash(text, precision);
 		if (!gser) {
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
@@ -960,22 +1401,24 @@ struct GPointFromGeoHashBinaryOperator {
 			Geometry::DestroyGeometry(gser);
 			throw ConversionException("Failure in geometry from geo hash: could not convert geo hash to geometry");
 		}
-		idx_t size = Geometry::GetGeometrySize(gserCentroid);
-		auto base = Geometry::GetBase(gserCentroid);
+		auto result_str = Geometry::ToGeometry(gserCentroid, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserCentroid);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryGPointFromGeoHashUnaryExecutor(Vector &text, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, GPointFromGeoHashUnaryOperator>(text, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, GPointFromGeoHashUnaryOperator>(text, result, count);
 }
 
 template <typename TA, typename TB, typename TR>
-static void GeometryGPointFromGeoHashBinaryExecutor(Vector &text, Vector &precision, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, GPointFromGeoHashBinaryOperator>(text, precision, result, count);
+static void GeometryGPointFromGeoHashBinaryExecutor(Vector &text_vec, Vector &precision_vec, Vector &result,
+                                                    idx_t count) {
+	BinaryExecutor::Execute<TA, TB, TR>(text_vec, precision_vec, result, count, [&](TA text, TB precision) {
+		return GPointFromGeoHashBinaryOperator::Operation<TA, TB, TR>(text, precision, result);
+	});
 }
 
 void GeoFunctions::GeometryGPointFromGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -991,7 +1434,7 @@ void GeoFunctions::GeometryGPointFromGeoHashFunction(DataChunk &args, Expression
 
 struct BoundaryUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
@@ -1003,17 +1446,16 @@ struct BoundaryUnaryOperator {
 		if (!gserBoundary) {
 			throw ConversionException("Failure in geometry boundary: could not getting boundary from geom");
 		}
-		idx_t size = Geometry::GetGeometrySize(gserBoundary);
-		auto base = Geometry::GetBase(gserBoundary);
+		auto result_str = Geometry::ToGeometry(gserBoundary, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserBoundary);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryBoundaryUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, BoundaryUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, BoundaryUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::GeometryBoundaryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -1027,12 +1469,16 @@ struct DimensionUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return -1;
 		}
+		int dimension;
+		if (WKBView(geom).TryDimension(dimension)) {
+			return dimension;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry dimension: could not getting dimension from geom");
 			return -1;
 		}
-		auto dimension = Geometry::LWGEOM_dimension(gser);
+		dimension = Geometry::LWGEOM_dimension(gser);
 		Geometry::DestroyGeometry(gser);
 		return dimension;
 	}
@@ -1064,10 +1510,9 @@ void GeometryDumpOperator(string_t geom, idx_t idx, LogicalType child_type, Vect
 	vector<Value> geom_values;
 	for (idx_t i = 0; i < gserArray.size(); i++) {
 		auto gserChild = gserArray[i];
-		idx_t rv_size = Geometry::GetGeometrySize(gserChild);
-		auto base = Geometry::GetBase(gserChild);
+		auto geometry = Geometry::ToGeometry(gserChild);
 		Geometry::DestroyGeometry(gserChild);
-		auto value = Value::BLOB((const_data_ptr_t)base, rv_size);
+		auto value = Value::BLOB((const_data_ptr_t)geometry.data(), geometry.size());
 		value.GetTypeMutable().CopyAuxInfo(child_type);
 		geom_values.emplace_back(value);
 	}
@@ -1174,6 +1619,7 @@ void GeoFunctions::GeometryDumpFunction(DataChunk &args, ExpressionState &state,
 struct EndPointUnaryOperator {
 	template <class TA, class TR>
 	static inline TR Operation(TA geom, ValidityMask &result_mask, idx_t i, void *dataptr) {
+		auto &result = *reinterpret_cast<Vector *>(dataptr);
 		if (geom.GetSize() == 0) {
 			return string_t();
 		}
@@ -1188,11 +1634,10 @@ struct EndPointUnaryOperator {
 			result_mask.SetInvalid(i);
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gserEndpoint);
-		auto base = Geometry::GetBase(gserEndpoint);
+		auto result_str = Geometry::ToGeometry(gserEndpoint, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserEndpoint);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
@@ -1212,6 +1657,11 @@ struct TypeUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return string_t();
 		}
+		// the type is in the header
+		WKBView view(geom);
+		if (view.IsValid()) {
+			return StringVector::AddString(result, Geometry::Geometrytype(view.GetType()));
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry dimension: could not getting dimension from geom");
@@ -1243,12 +1693,16 @@ struct IsClosedUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return false;
 		}
+		bool isClosed;
+		if (WKBView(geom).TryIsClosed(isClosed)) {
+			return isClosed;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is closed: could not getting closed from geom");
 			return false;
 		}
-		auto isClosed = Geometry::IsClosed(gser);
+		isClosed = Geometry::IsClosed(gser);
 		Geometry::DestroyGeometry(gser);
 		return isClosed;
 	}
@@ -1270,6 +1724,10 @@ struct IsCollectionUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return false;
 		}
+		WKBView view(geom);
+		if (view.IsValid()) {
+			return lwtype_is_collection(view.GetType());
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is collection: could not getting collection from geom");
@@ -1297,12 +1755,16 @@ struct IsEmptyUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return true;
 		}
+		bool isEmpty;
+		if (WKBView(geom).TryIsEmpty(isEmpty)) {
+			return isEmpty;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is empty: could not getting empty from geom");
 			return true;
 		}
-		auto isEmpty = Geometry::IsEmpty(gser);
+		isEmpty = Geometry::IsEmpty(gser);
 		Geometry::DestroyGeometry(gser);
 		return isEmpty;
 	}
@@ -1351,14 +1813,18 @@ struct NPointsUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
+		uint32_t nPoints;
+		if (WKBView(geom).TryNumPoints(nPoints)) {
+			return nPoints;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto nPoints = Geometry::NPoints(gser);
+		auto nPointsRv = Geometry::NPoints(gser);
 		Geometry::DestroyGeometry(gser);
-		return nPoints;
+		return nPointsRv;
 	}
 };
 
@@ -1378,12 +1844,16 @@ struct NumGeometriesUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
+		uint32_t numGeometries;
+		if (WKBView(geom).TryNumGeometries(numGeometries)) {
+			return numGeometries;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto numGeometries = Geometry::NumGeometries(gser);
+		numGeometries = Geometry::NumGeometries(gser);
 		Geometry::DestroyGeometry(gser);
 		return numGeometries;
 	}
@@ -1405,14 +1875,21 @@ struct NumPointsUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return 0;
 		}
+		WKBView view(geom);
+		uint32_t numPoints;
+		if (view.TryNumPoints(numPoints)) {
+			/* OGC says this functions is only valid on LINESTRING */
+			auto type = view.GetType();
+			return (type == LINETYPE || type == CIRCSTRINGTYPE || type == COMPOUNDTYPE) ? numPoints : 0;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry is ring: could not getting ring from geom");
 			return 0;
 		}
-		auto numPoints = Geometry::NumPoints(gser);
+		auto numPointsRv = Geometry::NumPoints(gser);
 		Geometry::DestroyGeometry(gser);
-		return numPoints;
+		return numPointsRv;
 	}
 };
 
@@ -1441,11 +1918,7 @@ static TR PointNScalarFunction(Vector &result, TA geom, TB index, ValidityMask &
 		mask.SetInvalid(idx);
 		return string_t();
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserPointN);
-	auto base = Geometry::GetBase(gserPointN);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserPointN, result);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserPointN);
 	return result_str;
@@ -1468,9 +1941,20 @@ void GeoFunctions::GeometryPointNFunction(DataChunk &args, ExpressionState &stat
 struct StartPointUnaryOperator {
 	template <class INPUT_TYPE, class RESULT_TYPE>
 	static inline RESULT_TYPE Operation(INPUT_TYPE geom, ValidityMask &result_mask, idx_t i, void *dataptr) {
+		auto &result = *reinterpret_cast<Vector *>(dataptr);
 		if (geom.GetSize() == 0) {
 			return string_t();
 		}
+		// the first vertex of a line is copied into a new point, without building an LWGEOM
+		WKBView view(geom);
+		POINT4D point;
+		if (view.TryGetStartPoint(point)) {
+			auto srid = view.GetSRID();
+			auto result_str = StringVector::EmptyString(result, WKBView::PointSize(view.HasZ(), view.HasM(), srid));
+			WKBView::WritePoint(point, view.HasZ(), view.HasM(), srid, (data_ptr_t)result_str.GetDataWriteable());
+			result_str.Finalize();
+			return result_str;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry gets start point: could not getting start point from geom");
@@ -1481,11 +1965,10 @@ struct StartPointUnaryOperator {
 			result_mask.SetInvalid(i);
 			return string_t();
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserStartPoint);
-		auto base = Geometry::GetBase(gserStartPoint);
+		auto result_str = Geometry::ToGeometry(gserStartPoint, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserStartPoint);
-		return string_t((const char *)base, rv_size);
+		return result_str;
 		;
 	}
 };
@@ -1508,6 +1991,11 @@ struct GetXUnaryOperator {
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
 			return 0.00;
 		}
+		WKBView view(geom);
+		POINT4D point;
+		if (view.TryGetPoint(point)) {
+			return point.x;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry gets X: could not getting X from geom");
@@ -1537,6 +2025,11 @@ struct GetYUnaryOperator {
 			//     "Failure in geometry get X: could not get coordinate X from geometry");
 			return 0.00;
 		}
+		WKBView view(geom);
+		POINT4D point;
+		if (view.TryGetPoint(point)) {
+			return point.y;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry gets Y: could not getting Y from geom");
@@ -1581,11 +2074,7 @@ static TR DifferenceScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserDiff = Geometry::Difference(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserDiff);
-	auto base = Geometry::GetBase(gserDiff);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserDiff, result);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserDiff);
@@ -1623,11 +2112,7 @@ static TR ClosestPointScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserClosestPoint = Geometry::ClosestPoint(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserClosestPoint);
-	auto base = Geometry::GetBase(gserClosestPoint);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserClosestPoint, result);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserClosestPoint);
@@ -1665,11 +2150,7 @@ static TR UnionScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserUnion = Geometry::GeometryUnion(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserUnion);
-	auto base = Geometry::GetBase(gserUnion);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserUnion, result);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserUnion);
@@ -1741,15 +2222,13 @@ void GeoFunctions::GeometryUnionArrayFunction(DataChunk &args, ExpressionState &
 		}
 		auto gsergeom = Geometry::GeometryUnionGArray(&gserArray[0], list_entry.length);
 		if (gsergeom) {
-			idx_t rv_size = Geometry::GetGeometrySize(gsergeom);
-			auto base = Geometry::GetBase(gsergeom);
+			result_entries[i] = Geometry::ToGeometry(gsergeom, result);
 			if (list_entry.length > 1) {
 				for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 					Geometry::DestroyGeometry(gserArray[child_idx]);
 				}
 			}
 			Geometry::DestroyGeometry(gsergeom);
-			result_entries[i] = string_t((const char *)base, rv_size);
 		} else {
 			result_entries[i] = string_t();
 		}
@@ -1774,11 +2253,7 @@ static TR IntersectionScalarFunction(Vector &result, TA geom1, TB geom2) {
 		return string_t();
 	}
 	auto gserIntersection = Geometry::GeometryIntersection(gser1, gser2);
-	idx_t rv_size = Geometry::GetGeometrySize(gserIntersection);
-	auto base = Geometry::GetBase(gserIntersection);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserIntersection, result);
 	Geometry::DestroyGeometry(gser1);
 	Geometry::DestroyGeometry(gser2);
 	Geometry::DestroyGeometry(gserIntersection);
@@ -1817,11 +2292,7 @@ static TR SimplifyScalarFunction(Vector &result, TA geom, TB dist) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserSimplify);
-	auto base = Geometry::GetBase(gserSimplify);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserSimplify, result);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserSimplify);
 	return result_str;
@@ -1842,7 +2313,7 @@ void GeoFunctions::GeometrySimplifyFunction(DataChunk &args, ExpressionState &st
 
 struct ConvexhullUnaryOperator {
 	template <class TA, class TR>
-	static inline TR Operation(TA geom) {
+	static inline TR Operation(TA geom, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
@@ -1858,17 +2329,16 @@ struct ConvexhullUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return string_t();
 		}
-		idx_t size = Geometry::GetGeometrySize(gserConvex);
-		auto base = Geometry::GetBase(gserConvex);
+		auto result_str = Geometry::ToGeometry(gserConvex, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserConvex);
-		return string_t((const char *)base, size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TR>
 static void GeometryConvexhullUnaryExecutor(Vector &geom, Vector &result, idx_t count) {
-	UnaryExecutor::Execute<TA, TR, ConvexhullUnaryOperator>(geom, result, count);
+	UnaryExecutor::ExecuteString<TA, TR, ConvexhullUnaryOperator>(geom, result, count);
 }
 
 void GeoFunctions::GeometryConvexhullFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -1895,11 +2365,7 @@ static TR SnapToGridScalarFunction(Vector &result, TA geom, TB size) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserSnapTogrid);
-	auto base = Geometry::GetBase(gserSnapTogrid);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserSnapTogrid, result);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserSnapTogrid);
 	return result_str;
@@ -1937,11 +2403,7 @@ static TR BufferScalarFunction(Vector &result, TA geom, TB radius) {
 		Geometry::DestroyGeometry(gser);
 		return geom;
 	}
-	idx_t rv_size = Geometry::GetGeometrySize(gserBuffer);
-	auto base = Geometry::GetBase(gserBuffer);
-	auto result_str = StringVector::EmptyString(result, rv_size);
-	memcpy(result_str.GetDataWriteable(), base, rv_size);
-	result_str.Finalize();
+	auto result_str = Geometry::ToGeometry(gserBuffer, result);
 	Geometry::DestroyGeometry(gser);
 	Geometry::DestroyGeometry(gserBuffer);
 	return result_str;
@@ -1962,7 +2424,7 @@ void GeoFunctions::GeometryBufferFunction(DataChunk &args, ExpressionState &stat
 
 struct BufferTextTernaryOperator {
 	template <class TA, class TB, class TC, class TR>
-	static inline TR Operation(TA geom, TB radius, TC styles) {
+	static inline TR Operation(TA geom, TB radius, TC styles, Vector &result) {
 		if (geom.GetSize() == 0) {
 			return string_t();
 		}
@@ -1980,18 +2442,20 @@ struct BufferTextTernaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return geom;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserBuffer);
-		auto base = Geometry::GetBase(gserBuffer);
+		auto result_str = Geometry::ToGeometry(gserBuffer, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserBuffer);
-		return string_t((const char *)base, rv_size);
+		return result_str;
 	}
 };
 
 template <typename TA, typename TB, typename TC, typename TR>
-static void BufferTextTernaryExecutor(Vector &geom, Vector &radius, Vector &styles, Vector &result, idx_t count) {
-	TernaryExecutor::Execute<TA, TB, TC, TR>(geom, radius, styles, result, count,
-	                                         BufferTextTernaryOperator::Operation<TA, TB, TC, TR>);
+static void BufferTextTernaryExecutor(Vector &geom_vec, Vector &radius_vec, Vector &styles_vec, Vector &result,
+                                      idx_t count) {
+	TernaryExecutor::Execute<TA, TB, TC, TR>(
+	    geom_vec, radius_vec, styles_vec, result, count, [&](TA geom, TB radius, TC styles) {
+		    return BufferTextTernaryOperator::Operation<TA, TB, TC, TR>(geom, radius, styles, result);
+	    });
 }
 
 void GeoFunctions::GeometryBufferTextFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -2002,6 +2466,144 @@ void GeoFunctions::GeometryBufferTextFunction(DataChunk &args, ExpressionState &
 	                                                                args.size());
 }
 
+//===--------------------------------------------------------------------===//
+// Bounding box short-circuit of the binary predicates
+//===--------------------------------------------------------------------===//
+//! The binary predicates whose result can often be decided from the 2D bounding boxes of their arguments
+enum class BBoxPredicate : uint8_t { EQUALS, CONTAINS, WITHIN, COVERS, COVEREDBY, INTERSECTS, DISJOINT, TOUCHES };
+
+//! The 2D bounding box of a non-empty geometry read straight from its WKB, plus the shapes that allow an exact answer
+struct WKBBBox {
+	GBOX box;
+	int32_t srid;
+	bool is_point;
+	bool is_rectangle;
+};
+
+static bool TryGetWKBBBox(string_t geom, WKBBBox &result) {
+	WKBView view(geom);
+	if (!view.TryGetBBox(result.box) || result.box.xmin > result.box.xmax) {
+		return false;
+	}
+	result.srid = view.GetSRID();
+	result.is_point = view.GetType() == POINTTYPE;
+	if (!view.TryIsRectangle(result.is_rectangle)) {
+		result.is_rectangle = false;
+	}
+	return true;
+}
+
+//! The predicate with its arguments swapped
+static BBoxPredicate BBoxConverse(BBoxPredicate predicate) {
+	switch (predicate) {
+	case BBoxPredicate::CONTAINS:
+		return BBoxPredicate::WITHIN;
+	case BBoxPredicate::WITHIN:
+		return BBoxPredicate::CONTAINS;
+	case BBoxPredicate::COVERS:
+		return BBoxPredicate::COVEREDBY;
+	case BBoxPredicate::COVEREDBY:
+		return BBoxPredicate::COVERS;
+	default:
+		return predicate;
+	}
+}
+
+static bool BBoxContains(const GBOX &outer, const GBOX &inner) {
+	return outer.xmin <= inner.xmin && inner.xmax <= outer.xmax && outer.ymin <= inner.ymin && inner.ymax <= outer.ymax;
+}
+
+//! Decide "predicate(rectangle, point)" exactly
+static bool RectanglePointPredicate(const GBOX &rect, const GBOX &point, BBoxPredicate predicate, bool &result) {
+	bool on_boundary = point.xmin == rect.xmin || point.xmin == rect.xmax || point.ymin == rect.ymin ||
+	                   point.ymin == rect.ymax;
+	switch (predicate) {
+	case BBoxPredicate::CONTAINS:
+		result = !on_boundary;
+		return true;
+	case BBoxPredicate::COVERS:
+	case BBoxPredicate::INTERSECTS:
+		result = true;
+		return true;
+	case BBoxPredicate::DISJOINT:
+		result = false;
+		return true;
+	case BBoxPredicate::TOUCHES:
+		result = on_boundary;
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! Decide the predicate from the bounding boxes of both (non-empty) arguments. Returns false if the boxes do not
+//! decide it, in which case the exact predicate has to run.
+static bool TryBBoxPredicate(const WKBBBox &bbox1, const WKBBBox &bbox2, BBoxPredicate predicate, bool &result) {
+	if (bbox1.srid != bbox2.srid) {
+		// let the exact predicate raise the mismatch
+		return false;
+	}
+	auto &box1 = bbox1.box;
+	auto &box2 = bbox2.box;
+	bool overlaps =
+	    box1.xmin <= box2.xmax && box2.xmin <= box1.xmax && box1.ymin <= box2.ymax && box2.ymin <= box1.ymax;
+	if (!overlaps) {
+		result = predicate == BBoxPredicate::DISJOINT;
+		return true;
+	}
+	switch (predicate) {
+	case BBoxPredicate::EQUALS:
+		if (!BBoxContains(box1, box2) || !BBoxContains(box2, box1)) {
+			result = false;
+			return true;
+		}
+		break;
+	case BBoxPredicate::CONTAINS:
+	case BBoxPredicate::COVERS:
+		if (!BBoxContains(box1, box2)) {
+			result = false;
+			return true;
+		}
+		break;
+	case BBoxPredicate::WITHIN:
+	case BBoxPredicate::COVEREDBY:
+		if (!BBoxContains(box2, box1)) {
+			result = false;
+			return true;
+		}
+		break;
+	default:
+		break;
+	}
+	// the boxes overlap: a point against a rectangle is still decided exactly
+	if (bbox1.is_rectangle && bbox2.is_point) {
+		return RectanglePointPredicate(box1, box2, predicate, result);
+	}
+	if (bbox1.is_point && bbox2.is_rectangle) {
+		return RectanglePointPredicate(box2, box1, BBoxConverse(predicate), result);
+	}
+	return false;
+}
+
+//! Wraps a binary predicate operator with the bounding box short-circuit, so that only the pairs the boxes can not
+//! decide are deserialized and handed to GEOS
+template <class OP, BBoxPredicate PREDICATE>
+struct BBoxShortCircuitOperator {
+	template <class TA, class TB, class TR>
+	static inline TR Operation(TA geom1, TB geom2) {
+		if (geom1.GetSize() != 0 && geom2.GetSize() != 0) {
+			WKBBBox bbox1;
+			WKBBBox bbox2;
+			bool result;
+			if (TryGetWKBBBox(geom1, bbox1) && TryGetWKBBBox(geom2, bbox2) &&
+			    TryBBoxPredicate(bbox1, bbox2, PREDICATE, result)) {
+				return result;
+			}
+		}
+		return OP::template Operation<TA, TB, TR>(geom1, geom2);
+	}
+};
+
 struct EqualsBinaryOperator {
 	template <class TA, class TB, class TR>
 	static inline TR Operation(TA geom1, TB geom2) {
@@ -2011,6 +2613,17 @@ struct EqualsBinaryOperator {
 		if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 			return false;
 		}
+		WKBView view1(geom1), view2(geom2);
+		if (view1.IsValid() && view2.IsValid() && view1.GetSRID() == view2.GetSRID()) {
+			/* Binary-equivalent geometries are equal, and so are two empty ones */
+			if (WKBView::BinaryEquals(view1, view2)) {
+				return true;
+			}
+			bool empty1, empty2;
+			if (view1.TryIsEmpty(empty1) && view2.TryIsEmpty(empty2) && empty1 && empty2) {
+				return true;
+			}
+		}
 		auto gser1 = Geometry::GetGserialized(geom1);
 		auto gser2 = Geometry::GetGserialized(geom2);
 		if (!gser1 || !gser2) {
@@ -2032,7 +2645,8 @@ struct EqualsBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryEqualsBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, EqualsBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<EqualsBinaryOperator, BBoxPredicate::EQUALS>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryEqualsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -2041,6 +2655,117 @@ void GeoFunctions::GeometryEqualsFunction(DataChunk &args, ExpressionState &stat
 	GeometryEqualsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
 }
 
+//! Per-thread cache of the prepared form of the constant argument of a spatial predicate
+struct PreparedPredicateLocalState : public FunctionLocalState {
+	~PreparedPredicateLocalState() override {
+		if (cache) {
+			Geometry::DestroyPreparedGeometry(cache);
+		}
+	}
+
+	//! Return the prepared geometry of the constant, preparing it again only if the constant changed
+	PrepGeomCache *GetCache(string_t constant) {
+		if (cache && constant_data.size() == constant.GetSize() &&
+		    memcmp(constant_data.data(), constant.GetDataUnsafe(), constant.GetSize()) == 0) {
+			return cache;
+		}
+		auto gser = Geometry::GetGserialized(constant);
+		if (!gser) {
+			throw ConversionException("Failure in geometry prepare: could not prepare geom");
+		}
+		if (cache) {
+			Geometry::DestroyPreparedGeometry(cache);
+			cache = nullptr;
+		}
+		cache = Geometry::PrepareGeometry(gser);
+		constant_data = constant.GetString();
+		has_bbox = TryGetWKBBBox(constant, bbox);
+		return cache;
+	}
+
+	PrepGeomCache *cache = nullptr;
+	//! The bytes of the constant the cache was built from
+	string constant_data;
+	//! The bounding box of the constant, used to skip deserializing the other argument
+	bool has_bbox = false;
+	WKBBBox bbox;
+};
+
+unique_ptr<FunctionLocalState> GeoFunctions::InitPreparedPredicateLocalState(ExpressionState &state,
+                                                                             const BoundFunctionExpression &expr,
+                                                                             FunctionData *bind_data) {
+	return make_unique<PreparedPredicateLocalState>();
+}
+
+static BBoxPredicate GetBBoxPredicate(PreparedPredicate predicate) {
+	switch (predicate) {
+	case PreparedPredicate::CONTAINS:
+		return BBoxPredicate::CONTAINS;
+	case PreparedPredicate::WITHIN:
+		return BBoxPredicate::WITHIN;
+	case PreparedPredicate::COVERS:
+		return BBoxPredicate::COVERS;
+	case PreparedPredicate::COVEREDBY:
+		return BBoxPredicate::COVEREDBY;
+	case PreparedPredicate::INTERSECTS:
+		return BBoxPredicate::INTERSECTS;
+	default:
+		return BBoxPredicate::DISJOINT;
+	}
+}
+
+//! Evaluate a predicate with exactly one constant argument against the cached prepared form of that argument.
+//! "predicate" is used when the first argument is constant, "swapped" (its converse) when the second one is.
+//! Returns false if the chunk does not qualify, in which case the plain binary operator runs instead.
+static bool ExecutePreparedPredicate(DataChunk &args, ExpressionState &state, Vector &result,
+                                     PreparedPredicate predicate, PreparedPredicate swapped) {
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	bool first_constant = geom1_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	bool second_constant = geom2_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	if (first_constant == second_constant) {
+		return false;
+	}
+	auto &constant_arg = first_constant ? geom1_arg : geom2_arg;
+	auto &other_arg = first_constant ? geom2_arg : geom1_arg;
+	if (ConstantVector::IsNull(constant_arg)) {
+		return false;
+	}
+	auto constant = ConstantVector::GetData<string_t>(constant_arg)[0];
+	if (constant.GetSize() == 0) {
+		return false;
+	}
+
+	auto &lstate = (PreparedPredicateLocalState &)*ExecuteFunctionState::GetFunctionState(state);
+	auto cache = lstate.GetCache(constant);
+	auto op = first_constant ? predicate : swapped;
+	auto bbox_op = GetBBoxPredicate(op);
+	UnaryExecutor::Execute<string_t, bool>(other_arg, result, args.size(), [&](string_t geom) {
+		if (geom.GetSize() == 0) {
+			return false;
+		}
+		bool rv;
+		WKBBBox bbox;
+		if (lstate.has_bbox && TryGetWKBBBox(geom, bbox) && TryBBoxPredicate(lstate.bbox, bbox, bbox_op, rv)) {
+			return rv;
+		}
+		WKBView view(geom);
+		POINT4D point;
+		if (view.GetType() == POINTTYPE && view.TryGetPoint(point) &&
+		    Geometry::GeometryPreparedPredicate(cache, POINT2D {point.x, point.y}, view.GetSRID(), op, rv)) {
+			return rv;
+		}
+		auto gser = Geometry::GetGserialized(geom);
+		if (!gser) {
+			throw ConversionException("Failure in geometry prepared predicate: could not getting geom");
+		}
+		rv = Geometry::GeometryPreparedPredicate(cache, gser, op);
+		Geometry::DestroyGeometry(gser);
+		return rv;
+	});
+	return true;
+}
+
 struct ContainsBinaryOperator {
 	template <class TA, class TB, class TR>
 	static inline TR Operation(TA geom1, TB geom2) {
@@ -2071,10 +2796,14 @@ struct ContainsBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryContainsBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, ContainsBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<ContainsBinaryOperator, BBoxPredicate::CONTAINS>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryContainsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::CONTAINS, PreparedPredicate::WITHIN)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryContainsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2110,7 +2839,8 @@ struct TouchesBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryTouchesBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, TouchesBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<TouchesBinaryOperator, BBoxPredicate::TOUCHES>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryTouchesFunction(DataChunk &args, ExpressionState &state, Vector &result) {
@@ -2149,10 +2879,14 @@ struct WithInBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryWithinBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, WithInBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<WithInBinaryOperator, BBoxPredicate::WITHIN>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::WITHIN, PreparedPredicate::CONTAINS)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryWithinBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2188,10 +2922,14 @@ struct IntersectsBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryIntersectsBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, IntersectsBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<IntersectsBinaryOperator, BBoxPredicate::INTERSECTS>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryIntersectsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::INTERSECTS, PreparedPredicate::INTERSECTS)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryIntersectsBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2227,10 +2965,14 @@ struct CoversBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryCoversBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, CoversBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<CoversBinaryOperator, BBoxPredicate::COVERS>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryCoversFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::COVERS, PreparedPredicate::COVEREDBY)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryCoversBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2266,10 +3008,14 @@ struct CoveredByBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryCoveredByBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, CoveredByBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<CoveredByBinaryOperator, BBoxPredicate::COVEREDBY>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryCoveredByFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::COVEREDBY, PreparedPredicate::COVERS)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryCoveredByBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2305,10 +3051,14 @@ struct DisjointBinaryOperator {
 
 template <typename TA, typename TB, typename TR>
 static void GeometryDisjointBinaryExecutor(Vector &geom1, Vector &geom2, Vector &result, idx_t count) {
-	BinaryExecutor::ExecuteStandard<TA, TB, TR, DisjointBinaryOperator>(geom1, geom2, result, count);
+	using OP = BBoxShortCircuitOperator<DisjointBinaryOperator, BBoxPredicate::DISJOINT>;
+	BinaryExecutor::ExecuteStandard<TA, TB, TR, OP>(geom1, geom2, result, count);
 }
 
 void GeoFunctions::GeometryDisjointFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (ExecutePreparedPredicate(args, state, result, PreparedPredicate::DISJOINT, PreparedPredicate::DISJOINT)) {
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	GeometryDisjointBinaryExecutor<string_t, string_t, bool>(geom1_arg, geom2_arg, result, args.size());
@@ -2349,7 +3099,130 @@ static void GeometryDWithinTernaryExecutor(Vector &geom1, Vector &geom2, Vector
 	                                         DWithinTernaryOperator::Operation<TA, TB, TC, TR>);
 }
 
+//! Whether a geography of this view has edges, i.e. is not made of points only
+static bool GeographyHasEdges(const WKBView &view) {
+	return view.GetType() != POINTTYPE && view.GetType() != MULTIPOINTTYPE;
+}
+
+//! Spherical bounding box test of the geodetic ST_DWithin: true if the vertex boxes of the two values, read from the
+//! WKB (or their cached prefix) without deserializing, are already further apart than the tolerance
+static bool GeographyDWithinBoxReject(const WKBView &view1, const GBOX &box1, string_t geom2, double tolerance,
+                                      bool use_spheroid) {
+	WKBView view2(geom2);
+	GBOX box2;
+	if (!view1.IsValid() || !view2.IsValid() || view1.GetSRID() != view2.GetSRID() || !view2.TryGetBBox(box2)) {
+		return false;
+	}
+	return Geometry::GeographyDWithinBoxReject(box1, GeographyHasEdges(view1), box2, GeographyHasEdges(view2),
+	                                           view1.GetSRID(), tolerance, use_spheroid);
+}
+
+static bool GeographyDWithinQuaternaryScalarFunction(string_t geom1, string_t geom2, double tolerance,
+                                                     bool use_spheroid) {
+	if (geom1.GetSize() == 0 && geom2.GetSize() == 0) {
+		return true;
+	}
+	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
+		return false;
+	}
+	if (tolerance < 0) {
+		throw ConversionException("Tolerance cannot be less than zero");
+	}
+	WKBView view1(geom1);
+	GBOX box1;
+	if (view1.TryGetBBox(box1) && GeographyDWithinBoxReject(view1, box1, geom2, tolerance, use_spheroid)) {
+		return false;
+	}
+	auto gser1 = Geometry::GetGserialized(geom1);
+	auto gser2 = Geometry::GetGserialized(geom2);
+	if (!gser1 || !gser2) {
+		if (gser1) {
+			Geometry::DestroyGeometry(gser1);
+		}
+		if (gser2) {
+			Geometry::DestroyGeometry(gser2);
+		}
+		throw ConversionException("Failure in geometry get dwithin: could not getting dwithin from geom");
+	}
+	auto dWithinRv = Geometry::GeographyDWithin(gser1, gser2, tolerance, use_spheroid);
+	Geometry::DestroyGeometry(gser1);
+	Geometry::DestroyGeometry(gser2);
+	return dWithinRv;
+}
+
+//! Geodetic ST_DWithin(geom1, geom2, meters, use_spheroid): a constant argument gets its box read and its circular
+//! tree built once; in every case the tree traversal stops as soon as a pair of nodes is found within the tolerance
+static void GeographyDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &lstate = (CircTreeLocalState &)*ExecuteFunctionState::GetFunctionState(state);
+	auto &geom1_arg = args.data[0];
+	auto &geom2_arg = args.data[1];
+	auto &tolerance_arg = args.data[2];
+	auto &use_spheroid_arg = args.data[3];
+	bool first_constant = geom1_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	bool second_constant = geom2_arg.GetVectorType() == VectorType::CONSTANT_VECTOR;
+
+	// one constant argument: only the other argument is decoded per row
+	if (first_constant != second_constant && tolerance_arg.GetVectorType() == VectorType::CONSTANT_VECTOR &&
+	    use_spheroid_arg.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		auto &constant_arg = first_constant ? geom1_arg : geom2_arg;
+		auto &other_arg = first_constant ? geom2_arg : geom1_arg;
+		if (ConstantVector::IsNull(constant_arg) || ConstantVector::IsNull(tolerance_arg) ||
+		    ConstantVector::IsNull(use_spheroid_arg)) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(result, true);
+			return;
+		}
+		auto constant = ConstantVector::GetData<string_t>(constant_arg)[0];
+		auto tolerance = ConstantVector::GetData<double>(tolerance_arg)[0];
+		auto use_spheroid = ConstantVector::GetData<bool>(use_spheroid_arg)[0];
+		if (tolerance < 0) {
+			throw ConversionException("Tolerance cannot be less than zero");
+		}
+		if (constant.GetSize() == 0) {
+			UnaryExecutor::Execute<string_t, bool>(other_arg, result, args.size(),
+			                                       [&](string_t geom) { return geom.GetSize() == 0; });
+			return;
+		}
+		WKBView view(constant);
+		GBOX box;
+		bool has_box = view.TryGetBBox(box);
+		CircTreeGeomCache *cache = nullptr;
+		UnaryExecutor::Execute<string_t, bool>(other_arg, result, args.size(), [&](string_t geom) {
+			if (geom.GetSize() == 0) {
+				return false;
+			}
+			if (has_box && GeographyDWithinBoxReject(view, box, geom, tolerance, use_spheroid)) {
+				return false;
+			}
+			// the tree is only built once a row passes the box test
+			if (!cache) {
+				cache = lstate.GetCache(constant);
+			}
+			auto gser = Geometry::GetGserialized(geom);
+			if (!gser) {
+				throw ConversionException("Failure in geometry get dwithin: could not getting dwithin from geom");
+			}
+			auto dWithinRv = Geometry::GeographyDWithin(cache, gser, tolerance, use_spheroid);
+			Geometry::DestroyGeometry(gser);
+			return dWithinRv;
+		});
+		return;
+	}
+
+	GenericExecutor::ExecuteQuaternary<PrimitiveType<string_t>, PrimitiveType<string_t>, PrimitiveType<double>,
+	                                   PrimitiveType<bool>, PrimitiveType<bool>>(
+	    geom1_arg, geom2_arg, tolerance_arg, use_spheroid_arg, result, args.size(),
+	    [&](PrimitiveType<string_t> geom1, PrimitiveType<string_t> geom2, PrimitiveType<double> tolerance,
+	        PrimitiveType<bool> use_spheroid) {
+		    return GeographyDWithinQuaternaryScalarFunction(geom1.val, geom2.val, tolerance.val, use_spheroid.val);
+	    });
+}
+
 void GeoFunctions::GeometryDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (args.data.size() == 4) {
+		GeographyDWithinFunction(args, state, result);
+		return;
+	}
 	auto &geom1_arg = args.data[0];
 	auto &geom2_arg = args.data[1];
 	auto &distance_arg = args.data[2];
@@ -2603,6 +3476,17 @@ static TR AzimuthScalarFunction(Vector &result, TA geom1, TB geom2, ValidityMask
 	if (geom1.GetSize() == 0 || geom2.GetSize() == 0) {
 		return 0.0;
 	}
+	WKBView view1(geom1), view2(geom2);
+	POINT4D point1, point2;
+	if (view1.TryGetPoint(point1) && view2.TryGetPoint(point2)) {
+		POINT2D p1 {point1.x, point1.y}, p2 {point2.x, point2.y};
+		auto azimuthRv = Geometry::GeometryAzimuth(p1, p2, view1.GetSRID());
+		if (isnan(azimuthRv)) {
+			mask.SetInvalid(idx);
+			return 0.0;
+		}
+		return azimuthRv;
+	}
 	auto gser1 = Geometry::GetGserialized(geom1);
 	auto gser2 = Geometry::GetGserialized(geom2);
 	if (!gser1 || !gser2) {
@@ -2698,6 +3582,15 @@ struct BoundingBoxUnaryOperator {
 		if (geom.GetSize() == 0) {
 			return geom;
 		}
+		// the box is cached in the value or computed straight from the WKB, only curves go through liblwgeom
+		WKBView view(geom);
+		GBOX box;
+		if (view.TryGetBBox(box) && box.xmin <= box.xmax) {
+			auto gserBoundingBox = Geometry::GeometryExtent(box, view.GetSRID());
+			auto result_str = Geometry::ToGeometry(gserBoundingBox, result);
+			Geometry::DestroyGeometry(gserBoundingBox);
+			return result_str;
+		}
 		auto gser = Geometry::GetGserialized(geom);
 		if (!gser) {
 			throw ConversionException("Failure in geometry get bounding box: could not getting bounding box from geom");
@@ -2713,11 +3606,7 @@ struct BoundingBoxUnaryOperator {
 			Geometry::DestroyGeometry(gser);
 			return geom;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserBoundingBox);
-		auto base = Geometry::GetBase(gserBoundingBox);
-		auto result_str = StringVector::EmptyString(result, rv_size);
-		memcpy(result_str.GetDataWriteable(), base, rv_size);
-		result_str.Finalize();
+		auto result_str = Geometry::ToGeometry(gserBoundingBox, result);
 		Geometry::DestroyGeometry(gser);
 		Geometry::DestroyGeometry(gserBoundingBox);
 		return result_str;
@@ -2734,6 +3623,74 @@ void GeoFunctions::GeometryBoundingBoxFunction(DataChunk &args, ExpressionState
 	GeometryBoundingBoxUnaryExecutor<string_t, string_t>(geom_arg, result, args.size());
 }
 
+struct AddBBoxUnaryOperator {
+	template <class TA, class TR>
+	static inline TR Operation(TA geom, Vector &result) {
+		if (geom.GetSize() == 0) {
+			return geom;
+		}
+		WKBView view(geom);
+		if (view.HasCachedBBox()) {
+			return StringVector::AddStringOrBlob(result, geom);
+		}
+		GBOX box;
+		if (!view.TryGetBBox(box)) {
+			auto gser = Geometry::GetGserialized(geom);
+			if (!gser) {
+				throw ConversionException("Failure in geometry add bbox: could not getting bounding box from geom");
+			}
+			auto has_box = Geometry::GeometryBBox(gser, box);
+			Geometry::DestroyGeometry(gser);
+			if (!has_box) {
+				return StringVector::AddStringOrBlob(result, geom);
+			}
+		}
+		if (box.xmin > box.xmax) {
+			// there is nothing to cache for an empty geometry
+			return StringVector::AddStringOrBlob(result, geom);
+		}
+		auto result_str = StringVector::EmptyString(result, GEOGRAPHY_BBOX_PREFIX_SIZE + geom.GetSize());
+		auto output = (data_ptr_t)result_str.GetDataWriteable();
+		WKBView::WriteBBoxPrefix(box, output);
+		memcpy(output + GEOGRAPHY_BBOX_PREFIX_SIZE, geom.GetDataUnsafe(), geom.GetSize());
+		result_str.Finalize();
+		return result_str;
+	}
+};
+
+void GeoFunctions::GeometryAddBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnaryExecutor::ExecuteString<string_t, string_t, AddBBoxUnaryOperator>(args.data[0], result, args.size());
+}
+
+struct DropBBoxUnaryOperator {
+	template <class TA, class TR>
+	static inline TR Operation(TA geom, Vector &result) {
+		if (geom.GetSize() == 0) {
+			return geom;
+		}
+		WKBView view(geom);
+		if (!view.HasCachedBBox()) {
+			return StringVector::AddStringOrBlob(result, geom);
+		}
+		return StringVector::AddStringOrBlob(result, string_t((const char *)view.GetData(), view.GetSize()));
+	}
+};
+
+void GeoFunctions::GeometryDropBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnaryExecutor::ExecuteString<string_t, string_t, DropBBoxUnaryOperator>(args.data[0], result, args.size());
+}
+
+struct HasBBoxUnaryOperator {
+	template <class TA, class TR>
+	static inline TR Operation(TA geom) {
+		return WKBView(geom).HasCachedBBox();
+	}
+};
+
+void GeoFunctions::GeometryHasBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	UnaryExecutor::Execute<string_t, bool, HasBBoxUnaryOperator>(args.data[0], result, args.size());
+}
+
 struct GeometryMaxDistanceBinaryOperator {
 	template <class TA, class TB, class TR>
 	static inline TR Operation(TA geom1, TB geom2) {
@@ -2829,14 +3786,342 @@ void GeoFunctions::GeometryExtentFunction(DataChunk &args, ExpressionState &stat
 			result_entries[i] = string_t();
 			continue;
 		}
-		idx_t rv_size = Geometry::GetGeometrySize(gserExtent);
-		auto base = Geometry::GetBase(gserExtent);
+		result_entries[i] = Geometry::ToGeometry(gserExtent, result);
 		for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 			Geometry::DestroyGeometry(gserArray[child_idx]);
 		}
 		Geometry::DestroyGeometry(gserExtent);
-		result_entries[i] = string_t((const char *)base, rv_size);
 	}
 }
 
+//! Reads the x and y children of a GEOGRAPHY_POINT vector. A row is NULL if the struct or one of its children is.
+struct PointVectorReader {
+	PointVectorReader(Vector &points, idx_t count) {
+		// the children of a dictionary are indexed by the dictionary's child, not by row
+		if (points.GetVectorType() == VectorType::DICTIONARY_VECTOR) {
+			points.Flatten(count);
+		}
+		points.ToUnifiedFormat(count, point_data);
+		auto &entries = StructVector::GetEntries(points);
+		entries[0]->ToUnifiedFormat(count, x_data);
+		entries[1]->ToUnifiedFormat(count, y_data);
+	}
+
+	bool TryGetPoint(idx_t row, POINT2D &point) const {
+		auto idx = point_data.sel->get_index(row);
+		if (!point_data.validity.RowIsValid(idx)) {
+			return false;
+		}
+		auto x_idx = x_data.sel->get_index(idx);
+		auto y_idx = y_data.sel->get_index(idx);
+		if (!x_data.validity.RowIsValid(x_idx) || !y_data.validity.RowIsValid(y_idx)) {
+			return false;
+		}
+		point.x = ((double *)x_data.data)[x_idx];
+		point.y = ((double *)y_data.data)[y_idx];
+		return true;
+	}
+
+	UnifiedVectorFormat point_data;
+	UnifiedVectorFormat x_data;
+	UnifiedVectorFormat y_data;
+};
+
+//! Read the coordinates of a GEOGRAPHY holding a POINT, returns false if it is empty. The SRID is dropped.
+static bool TryGetPackedPoint(string_t geom, POINT2D &point) {
+	if (geom.GetSize() == 0) {
+		return false;
+	}
+	WKBView view(geom);
+	if (!view.IsValid()) {
+		throw ConversionException("Failure in geometry cast: could not cast geometry to point");
+	}
+	if (view.GetType() != POINTTYPE) {
+		throw ConversionException("Failure in geometry cast: only a POINT can be cast to GEOGRAPHY_POINT");
+	}
+	bool is_empty;
+	if (view.TryIsEmpty(is_empty) && is_empty) {
+		return false;
+	}
+	POINT4D point4d;
+	if (view.TryGetPoint(point4d)) {
+		point.x = point4d.x;
+		point.y = point4d.y;
+		return true;
+	}
+	auto gser = Geometry::GetGserialized(geom);
+	if (!gser) {
+		throw ConversionException("Failure in geometry cast: could not cast geometry to point");
+	}
+	point.x = Geometry::XPoint(gser);
+	point.y = Geometry::YPoint(gser);
+	Geometry::DestroyGeometry(gser);
+	return true;
+}
+
+//! Write the points read by read_point(row, point) into a GEOGRAPHY_POINT vector
+template <class READ_POINT>
+static void WritePackedPoints(Vector &result, idx_t count, READ_POINT read_point) {
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto &entries = StructVector::GetEntries(result);
+	auto xs = FlatVector::GetData<double>(*entries[0]);
+	auto ys = FlatVector::GetData<double>(*entries[1]);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D point;
+		if (!read_point(i, point)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		xs[i] = point.x;
+		ys[i] = point.y;
+	}
+}
+
+bool GeoFunctions::CastPointToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	PointVectorReader reader(source, count);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<string_t>(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D point;
+		if (!reader.TryGetPoint(i, point)) {
+			FlatVector::SetNull(result, i, true);
+			continue;
+		}
+		result_data[i] = MakePointBinaryOperator::Operation<double, double, string_t>(point.x, point.y, result);
+	}
+	return true;
+}
+
+bool GeoFunctions::CastGeoToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	UnifiedVectorFormat source_data;
+	source.ToUnifiedFormat(count, source_data);
+	auto geoms = (string_t *)source_data.data;
+	WritePackedPoints(result, count, [&](idx_t row, POINT2D &point) {
+		auto idx = source_data.sel->get_index(row);
+		return source_data.validity.RowIsValid(idx) && TryGetPackedPoint(geoms[idx], point);
+	});
+	return true;
+}
+
+bool GeoFunctions::CastVarcharToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	UnifiedVectorFormat source_data;
+	source.ToUnifiedFormat(count, source_data);
+	auto texts = (string_t *)source_data.data;
+	WKTReader reader;
+	string wkb;
+	WritePackedPoints(result, count, [&](idx_t row, POINT2D &point) {
+		auto idx = source_data.sel->get_index(row);
+		if (!source_data.validity.RowIsValid(idx) || texts[idx].GetSize() == 0) {
+			return false;
+		}
+		if (reader.TryRead(texts[idx].GetDataUnsafe(), texts[idx].GetSize())) {
+			wkb.resize(reader.GetWKBSize());
+			reader.WriteWKB((data_ptr_t)&wkb[0]);
+			return TryGetPackedPoint(string_t(wkb), point);
+		}
+		auto gser = Geometry::ToGserialized(texts[idx]);
+		if (!gser) {
+			throw ConversionException("Failure in geometry cast: could not cast geometry from varchar");
+		}
+		wkb = Geometry::ToGeometry(gser);
+		Geometry::DestroyGeometry(gser);
+		return TryGetPackedPoint(string_t(wkb), point);
+	});
+	return true;
+}
+
+bool GeoFunctions::CastNullToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::SetNull(result, true);
+	return true;
+}
+
+static bool AllArgumentsConstant(DataChunk &args) {
+	for (auto &arg : args.data) {
+		if (arg.GetVectorType() != VectorType::CONSTANT_VECTOR) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Evaluate op(point, mask, row) over the rows of a GEOGRAPHY_POINT argument, a NULL point gives a NULL result
+template <class TR, class OP>
+static void ExecutePointUnary(DataChunk &args, Vector &result, OP op) {
+	bool constant = AllArgumentsConstant(args);
+	idx_t count = constant ? 1 : args.size();
+	PointVectorReader reader(args.data[0], count);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<TR>(result);
+	auto &mask = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D point;
+		if (!reader.TryGetPoint(i, point)) {
+			mask.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = op(point, mask, i);
+	}
+	if (constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+//! Evaluate op(point1, point2, mask, row) over the rows of two GEOGRAPHY_POINT arguments. The remaining arguments are
+//! read by op; a NULL point gives a NULL result.
+template <class TR, class OP>
+static void ExecutePointBinary(DataChunk &args, Vector &result, OP op) {
+	bool constant = AllArgumentsConstant(args);
+	idx_t count = constant ? 1 : args.size();
+	PointVectorReader reader1(args.data[0], count);
+	PointVectorReader reader2(args.data[1], count);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<TR>(result);
+	auto &mask = FlatVector::Validity(result);
+	for (idx_t i = 0; i < count; i++) {
+		POINT2D point1;
+		POINT2D point2;
+		if (!reader1.TryGetPoint(i, point1) || !reader2.TryGetPoint(i, point2)) {
+			mask.SetInvalid(i);
+			continue;
+		}
+		result_data[i] = op(point1, point2, mask, i);
+	}
+	if (constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+void GeoFunctions::PointGetXFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePointUnary<double>(args, result,
+	                          [&](const POINT2D &point, ValidityMask &mask, idx_t idx) { return point.x; });
+}
+
+void GeoFunctions::PointGetYFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePointUnary<double>(args, result,
+	                          [&](const POINT2D &point, ValidityMask &mask, idx_t idx) { return point.y; });
+}
+
+//! Geography distances of the point pairs in the first two arguments, batched per spheroid setting as in the
+//! GEOGRAPHY point path. use_spheroid_arg is null for the sphere; rows with a NULL input are marked in mask.
+static void PointPairDistances(DataChunk &args, Vector *use_spheroid_arg, idx_t count, double *distances,
+                               ValidityMask &mask) {
+	PointVectorReader reader1(args.data[0], count);
+	PointVectorReader reader2(args.data[1], count);
+	UnifiedVectorFormat use_spheroid_data;
+	if (use_spheroid_arg) {
+		use_spheroid_arg->ToUnifiedFormat(count, use_spheroid_data);
+	}
+
+	vector<double> lon1, lat1, lon2, lat2;
+	vector<idx_t> rows;
+	for (auto use_spheroid : {false, true}) {
+		lon1.clear();
+		lat1.clear();
+		lon2.clear();
+		lat2.clear();
+		rows.clear();
+		for (idx_t i = 0; i < count; i++) {
+			POINT2D point1;
+			POINT2D point2;
+			if (!reader1.TryGetPoint(i, point1) || !reader2.TryGetPoint(i, point2)) {
+				mask.SetInvalid(i);
+				continue;
+			}
+			bool row_spheroid = false;
+			if (use_spheroid_arg) {
+				auto idx = use_spheroid_data.sel->get_index(i);
+				if (!use_spheroid_data.validity.RowIsValid(idx)) {
+					mask.SetInvalid(i);
+					continue;
+				}
+				row_spheroid = ((bool *)use_spheroid_data.data)[idx];
+			}
+			if (row_spheroid != use_spheroid) {
+				continue;
+			}
+			lon1.push_back(point1.x);
+			lat1.push_back(point1.y);
+			lon2.push_back(point2.x);
+			lat2.push_back(point2.y);
+			rows.push_back(i);
+		}
+		if (rows.empty()) {
+			continue;
+		}
+		vector<double> batch(rows.size());
+		Geometry::PointDistance(lon1.data(), lat1.data(), lon2.data(), lat2.data(), rows.size(), SRID_UNKNOWN,
+		                        use_spheroid, batch.data());
+		for (idx_t i = 0; i < rows.size(); i++) {
+			distances[rows[i]] = batch[i];
+		}
+	}
+}
+
+void GeoFunctions::PointDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	bool constant = AllArgumentsConstant(args);
+	idx_t count = constant ? 1 : args.size();
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	PointPairDistances(args, args.data.size() == 3 ? &args.data[2] : nullptr, count,
+	                   FlatVector::GetData<double>(result), FlatVector::Validity(result));
+	if (constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+
+void GeoFunctions::PointAzimuthFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePointBinary<double>(
+	    args, result, [&](const POINT2D &point1, const POINT2D &point2, ValidityMask &mask, idx_t idx) {
+		    auto azimuthRv = Geometry::GeometryAzimuth(point1, point2, SRID_UNKNOWN);
+		    if (isnan(azimuthRv)) {
+			    mask.SetInvalid(idx);
+			    return 0.0;
+		    }
+		    return azimuthRv;
+	    });
+}
+
+void GeoFunctions::PointDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	bool constant = AllArgumentsConstant(args);
+	idx_t count = constant ? 1 : args.size();
+	UnifiedVectorFormat tolerance_data;
+	args.data[2].ToUnifiedFormat(count, tolerance_data);
+	auto tolerances = (double *)tolerance_data.data;
+
+	// geodesic: compare the batched point distances, as the GEOGRAPHY overload compares its tree distance
+	bool geodesic = args.data.size() == 4;
+	vector<double> distances;
+	ValidityMask distance_mask(count);
+	if (geodesic) {
+		distances.resize(count);
+		PointPairDistances(args, &args.data[3], count, distances.data(), distance_mask);
+	}
+
+	ExecutePointBinary<bool>(
+	    args, result, [&](const POINT2D &point1, const POINT2D &point2, ValidityMask &mask, idx_t idx) {
+		    auto tolerance_idx = tolerance_data.sel->get_index(idx);
+		    if (!tolerance_data.validity.RowIsValid(tolerance_idx) || !distance_mask.RowIsValid(idx)) {
+			    mask.SetInvalid(idx);
+			    return false;
+		    }
+		    auto tolerance = tolerances[tolerance_idx];
+		    if (tolerance < 0) {
+			    throw ConversionException("Tolerance cannot be less than zero");
+		    }
+		    if (geodesic) {
+			    return distances[idx] <= tolerance;
+		    }
+		    auto dx = point1.x - point2.x;
+		    auto dy = point1.y - point2.y;
+		    return sqrt(dx * dx + dy * dy) <= tolerance;
+	    });
+}
+
+void GeoFunctions::PointEqualsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	ExecutePointBinary<bool>(
+	    args, result, [&](const POINT2D &point1, const POINT2D &point2, ValidityMask &mask, idx_t idx) {
+		    return point1.x == point2.x && point1.y == point2.y;
+	    });
+}
+
 } // namespace duckdb
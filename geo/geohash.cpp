@@ -0,0 +1,238 @@
+#include "geohash.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+static const char *GEOHASH_BASE32 = "0123456789bcdefghjkmnpqrstuvwxyz";
+
+//! Width of a cell after GEOHASH_AXIS_BITS steps; the cell boundaries below that depth are all exact doubles
+static const double GEOHASH_LON_STEP = 360.0 / 4294967296.0;
+static const double GEOHASH_LAT_STEP = 180.0 / 4294967296.0;
+
+static inline uint32_t QuantizeCoordinate(double value, double min, double step) {
+	double cell = (value - min) / step;
+	/* NaN compares false everywhere, so the bisection never sets a bit for it */
+	if (!(cell >= 0)) {
+		return 0;
+	}
+	uint64_t result = cell >= 4294967295.0 ? 4294967295ULL : (uint64_t)cell;
+	/* The division is off by far less than a cell, so comparing with the exact boundaries settles the rounding */
+	result -= result > 0 && value < min + (double)result * step;
+	result += result < 4294967295ULL && value >= min + (double)(result + 1) * step;
+	return (uint32_t)result;
+}
+
+uint32_t GeoHash::QuantizeLongitude(double lon) {
+	return QuantizeCoordinate(lon, -180.0, GEOHASH_LON_STEP);
+}
+
+uint32_t GeoHash::QuantizeLatitude(double lat) {
+	return QuantizeCoordinate(lat, -90.0, GEOHASH_LAT_STEP);
+}
+
+bool GeoHash::IsInRange(const GBOX &box) {
+	return !(box.xmin < -180 || box.ymin < -90 || box.xmax > 180 || box.ymax > 90);
+}
+
+void GeoHash::BoxCenter(const GBOX &box, double &lon, double &lat) {
+	lon = box.xmin + (box.xmax - box.xmin) / 2;
+	lat = box.ymin + (box.ymax - box.ymin) / 2;
+}
+
+int GeoHash::BoxPrecision(const GBOX &box) {
+	GBOX bounds;
+	gbox_init(&bounds);
+	return lwgeom_geohash_precision(box, &bounds);
+}
+
+void GeoHash::Encode(const double *lon, const double *lat, idx_t count, uint64_t *result) {
+	for (idx_t i = 0; i < count; i++) {
+		result[i] = Interleave(QuantizeCoordinate(lon[i], -180.0, GEOHASH_LON_STEP),
+		                       QuantizeCoordinate(lat[i], -90.0, GEOHASH_LAT_STEP));
+	}
+}
+
+//! Bounds of the cell numbered cell after bits steps of bisection of [min, min + width]. Exact for bits up to 47.
+static void CellBounds(uint64_t cell, idx_t bits, double min, double width, double *bounds) {
+	double step = width / (double)(1ULL << bits);
+	bounds[0] = min + (double)cell * step;
+	bounds[1] = min + (double)(cell + 1) * step;
+}
+
+void GeoHash::WriteText(double lon, double lat, idx_t precision, char *target) {
+	auto lon_cell = QuantizeLongitude(lon);
+	auto lat_cell = QuantizeLatitude(lat);
+	auto hash = Interleave(lon_cell, lat_cell);
+	idx_t i = 0;
+	for (; i < precision && i < GEOHASH_INTEGER_CHARS; i++) {
+		target[i] = GEOHASH_BASE32[(hash >> (59 - 5 * i)) & 0x1F];
+	}
+	if (i == precision) {
+		return;
+	}
+
+	/* Past the integer, continue the bisection of geohash_point from the cell reached after 60 bits */
+	double lon_bounds[2], lat_bounds[2];
+	CellBounds(lon_cell >> 2, 30, -180.0, 360.0, lon_bounds);
+	CellBounds(lat_cell >> 2, 30, -90.0, 180.0, lat_bounds);
+	bool is_even = true;
+	int bit = 0, ch = 0;
+	while (i < precision) {
+		if (is_even) {
+			double mid = (lon_bounds[0] + lon_bounds[1]) / 2;
+			if (lon >= mid) {
+				ch |= 16 >> bit;
+				lon_bounds[0] = mid;
+			} else {
+				lon_bounds[1] = mid;
+			}
+		} else {
+			double mid = (lat_bounds[0] + lat_bounds[1]) / 2;
+			if (lat >= mid) {
+				ch |= 16 >> bit;
+				lat_bounds[0] = mid;
+			} else {
+				lat_bounds[1] = mid;
+			}
+		}
+		is_even = !is_even;
+		if (bit < 4) {
+			bit++;
+		} else {
+			target[i++] = GEOHASH_BASE32[ch];
+			bit = 0;
+			ch = 0;
+		}
+	}
+}
+
+//! Value of a base32 GeoHash character, ignoring case, or -1
+static int Base32Value(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'A' && c <= 'Z') {
+		c = c - 'A' + 'a';
+	}
+	/* The alphabet skips a, i, l and o */
+	if (c < 'b' || c > 'z' || c == 'i' || c == 'l' || c == 'o') {
+		return -1;
+	}
+	return c - 'b' + 10 - (c > 'i') - (c > 'l') - (c > 'o');
+}
+
+bool GeoHash::TryDecodeBBox(const char *hash, idx_t size, int precision, GBOX &result) {
+	idx_t length = 0;
+	while (length < size && hash[length] != '\0') {
+		length++;
+	}
+	if (precision < 0 || (idx_t)precision > length) {
+		precision = (int)length;
+	}
+
+	idx_t i = 0;
+	uint64_t bits = 0;
+	for (; i < (idx_t)precision && i < GEOHASH_INTEGER_CHARS; i++) {
+		auto value = Base32Value(hash[i]);
+		if (value < 0) {
+			return false;
+		}
+		bits = (bits << 5) | (uint64_t)value;
+	}
+	/* The longitude takes the first bit of the string, so it gets the extra bit of an odd count */
+	idx_t nbits = 5 * i;
+	uint32_t lon_cell, lat_cell;
+	Deinterleave(nbits > 0 ? bits << (64 - nbits) : 0, lon_cell, lat_cell);
+	idx_t lon_bits = (nbits + 1) / 2;
+	idx_t lat_bits = nbits / 2;
+	double lon[2], lat[2];
+	CellBounds(lon_bits ? lon_cell >> (GEOHASH_AXIS_BITS - lon_bits) : 0, lon_bits, -180.0, 360.0, lon);
+	CellBounds(lat_bits ? lat_cell >> (GEOHASH_AXIS_BITS - lat_bits) : 0, lat_bits, -90.0, 180.0, lat);
+
+	/* Past the integer, continue the bisection of decode_geohash_bbox */
+	bool is_even = nbits % 2 == 0;
+	for (; i < (idx_t)precision; i++) {
+		auto value = Base32Value(hash[i]);
+		if (value < 0) {
+			return false;
+		}
+		for (int j = 4; j >= 0; j--) {
+			bool set = value & (1 << j);
+			if (is_even) {
+				lon[!set] = (lon[0] + lon[1]) / 2;
+			} else {
+				lat[!set] = (lat[0] + lat[1]) / 2;
+			}
+			is_even = !is_even;
+		}
+	}
+
+	memset(&result, 0, sizeof(GBOX));
+	result.xmin = lon[0];
+	result.xmax = lon[1];
+	result.ymin = lat[0];
+	result.ymax = lat[1];
+	return true;
+}
+
+void GeoHash::EnvelopeCentroid(const GBOX &box, double &x, double &y) {
+	/* The envelope is the POINT, LINESTRING or POLYGON of BOX2D_to_LWGEOM, and the operations below are the ones of
+	 * geos::algorithm::Centroid on it, in the same order, so the point is the one ST_CENTROID gives */
+	if (box.xmin == box.xmax && box.ymin == box.ymax) {
+		x = box.xmin;
+		y = box.ymin;
+		return;
+	}
+	POINT2D ring[5] = {{box.xmin, box.ymin}, {box.xmin, box.ymax}, {box.xmax, box.ymax}, {box.xmax, box.ymin},
+	                   {box.xmin, box.ymin}};
+	POINT2D line[2] = {{box.xmin, box.ymin}, {box.xmax, box.ymax}};
+	bool is_polygon = box.xmin != box.xmax && box.ymin != box.ymax;
+	const POINT2D *points = is_polygon ? ring : line;
+	idx_t npoints = is_polygon ? 5 : 2;
+
+	/* Centroid::addShell, the ring is clockwise so its area is positive */
+	double cg3_x = 0.0, cg3_y = 0.0, areasum2 = 0.0;
+	if (is_polygon) {
+		auto &p0 = points[0];
+		for (idx_t i = 0; i < npoints - 1; i++) {
+			auto &p1 = points[i];
+			auto &p2 = points[i + 1];
+			double c_x = p0.x + p1.x + p2.x;
+			double c_y = p0.y + p1.y + p2.y;
+			double a2 = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+			cg3_x += 1.0 * a2 * c_x;
+			cg3_y += 1.0 * a2 * c_y;
+			areasum2 += 1.0 * a2;
+		}
+	}
+	/* Centroid::addLineSegments */
+	double line_x = 0.0, line_y = 0.0, length = 0.0;
+	for (idx_t i = 0; i < npoints - 1; i++) {
+		double dx = points[i].x - points[i + 1].x;
+		double dy = points[i].y - points[i + 1].y;
+		double segment_length = std::sqrt(dx * dx + dy * dy);
+		if (segment_length == 0.0) {
+			continue;
+		}
+		length += segment_length;
+		line_x += segment_length * ((points[i].x + points[i + 1].x) / 2);
+		line_y += segment_length * ((points[i].y + points[i + 1].y) / 2);
+	}
+	/* Centroid::getCentroid */
+	if (std::abs(areasum2) > 0.0) {
+		x = cg3_x / 3 / areasum2;
+		y = cg3_y / 3 / areasum2;
+	} else if (length > 0.0) {
+		x = line_x / length;
+		y = line_y / length;
+	} else {
+		x = points[0].x;
+		y = points[0].y;
+	}
+}
+
+} // namespace duckdb
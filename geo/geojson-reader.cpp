@@ -0,0 +1,627 @@
+#include "geojson-reader.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace duckdb {
+
+//! Values nested this deep are left to json-c, which stops at JSON_TOKENER_DEFAULT_DEPTH
+#define GEOJSON_READER_MAX_DEPTH 31
+
+static inline bool IsDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline bool IsHexDigit(char c) {
+	return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+//! Same as is_ws_char of json-c
+static inline bool IsWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+//! The characters json-c requires after a number inside a container, without its extensions
+static inline bool IsNumberDelimiter(char c) {
+	return IsWhitespace(c) || c == ',' || c == ']' || c == '}';
+}
+
+//! Compare a member name the way findMemberByName does
+static inline bool NameEquals(const char *name, idx_t len, const char *expected) {
+	return strlen(expected) == len && strncasecmp(name, expected, len) == 0;
+}
+
+static uint8_t LWTypeFromGeoJSONType(const char *name, idx_t len) {
+	if (NameEquals(name, len, "Point")) {
+		return POINTTYPE;
+	} else if (NameEquals(name, len, "LineString")) {
+		return LINETYPE;
+	} else if (NameEquals(name, len, "Polygon")) {
+		return POLYGONTYPE;
+	} else if (NameEquals(name, len, "MultiPoint")) {
+		return MULTIPOINTTYPE;
+	} else if (NameEquals(name, len, "MultiLineString")) {
+		return MULTILINETYPE;
+	} else if (NameEquals(name, len, "MultiPolygon")) {
+		return MULTIPOLYGONTYPE;
+	} else if (NameEquals(name, len, "GeometryCollection")) {
+		return COLLECTIONTYPE;
+	}
+	return 0;
+}
+
+void GeoJSONReader::SkipWhitespace() {
+	while (pos < end && IsWhitespace(*pos)) {
+		pos++;
+	}
+}
+
+bool GeoJSONReader::Consume(char c) {
+	SkipWhitespace();
+	if (pos < end && *pos == c) {
+		pos++;
+		return true;
+	}
+	return false;
+}
+
+bool GeoJSONReader::ConsumeLiteral(const char *literal, idx_t len) {
+	/* json-c also takes other cases in non-strict mode, those are left to it */
+	if ((idx_t)(end - pos) >= len && memcmp(pos, literal, len) == 0) {
+		pos += len;
+		return true;
+	}
+	return false;
+}
+
+//! Read a string and set str and len to its raw contents. The escape sequences are checked as json-c does, but not
+//! decoded: escaped tells the caller the contents cannot be compared as is.
+bool GeoJSONReader::ReadString(const char *&str, idx_t &len, bool &escaped) {
+	SkipWhitespace();
+	if (pos == end || *pos != '"') {
+		return false;
+	}
+	auto p = pos + 1;
+	str = p;
+	escaped = false;
+	for (; p < end && *p != '"'; p++) {
+		if (*p == '\0') {
+			/* json-c reads the text up to its first NUL */
+			return false;
+		}
+		if (*p == '\\') {
+			escaped = true;
+			if (++p == end) {
+				return false;
+			}
+			if (*p == 'u') {
+				for (idx_t i = 0; i < 4; i++) {
+					if (++p == end || !IsHexDigit(*p)) {
+						return false;
+					}
+				}
+			} else if (*p == '\0' || !strchr("\"\\/bfnrt", *p)) {
+				return false;
+			}
+		}
+	}
+	if (p == end) {
+		return false;
+	}
+	len = p - str;
+	pos = p + 1;
+	return true;
+}
+
+bool GeoJSONReader::ReadMemberName(const char *&name, idx_t &len) {
+	bool escaped;
+	return ReadString(name, len, escaped) && !escaped && Consume(':');
+}
+
+/*
+ * Read a number with the strict JSON syntax -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][-+]?[0-9]+)? followed by a delimiter.
+ * json-c reads integers with strtoll and converts them, and the rest with strtod. Both are correctly rounded, as are
+ * Clinger's fast path and strtod here; the only difference is -0, which is an integer zero for json-c. Integers with
+ * more than 18 digits may overflow strtoll and are left to json-c.
+ */
+bool GeoJSONReader::ReadNumber(double &result) {
+	SkipWhitespace();
+	auto start = pos;
+	auto p = pos;
+	bool negative = false;
+	if (p < end && *p == '-') {
+		negative = true;
+		p++;
+	}
+	if (p == end || !IsDigit(*p) || (*p == '0' && p + 1 < end && IsDigit(p[1]))) {
+		return false;
+	}
+
+	uint64_t mantissa = 0;
+	int significant_digits = 0;
+	int exponent = 0;
+	bool exact = true;
+	idx_t integer_digits = 0;
+	for (; p < end && IsDigit(*p); p++, integer_digits++) {
+		auto digit = *p - '0';
+		if (mantissa == 0 && digit == 0) {
+			continue;
+		}
+		if (significant_digits == 19) {
+			exact = false;
+			continue;
+		}
+		mantissa = mantissa * 10 + digit;
+		significant_digits++;
+	}
+	bool integer = true;
+	if (p < end && *p == '.') {
+		integer = false;
+		p++;
+		if (p == end || !IsDigit(*p)) {
+			return false;
+		}
+		for (; p < end && IsDigit(*p); p++) {
+			auto digit = *p - '0';
+			if (mantissa == 0 && digit == 0) {
+				exponent--;
+				continue;
+			}
+			if (significant_digits == 19) {
+				exact = false;
+				continue;
+			}
+			mantissa = mantissa * 10 + digit;
+			significant_digits++;
+			exponent--;
+		}
+	}
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		integer = false;
+		p++;
+		bool negative_exponent = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative_exponent = *p == '-';
+			p++;
+		}
+		if (p == end || !IsDigit(*p)) {
+			return false;
+		}
+		int explicit_exponent = 0;
+		for (; p < end && IsDigit(*p); p++) {
+			if (explicit_exponent < 10000) {
+				explicit_exponent = explicit_exponent * 10 + (*p - '0');
+			}
+		}
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+	}
+	if (p == end || !IsNumberDelimiter(*p) || (integer && integer_digits > 18)) {
+		return false;
+	}
+	pos = p;
+
+	double value;
+	if (integer && mantissa == 0) {
+		result = 0;
+	} else if (exact && WKBBuilder::TryExactDouble(mantissa, exponent, value)) {
+		result = negative ? -value : value;
+	} else {
+		/* The delimiter stops strtod before the end of the text */
+		result = strtod(start, nullptr);
+	}
+	return true;
+}
+
+bool GeoJSONReader::SkipValue(idx_t depth) {
+	if (depth >= GEOJSON_READER_MAX_DEPTH) {
+		return false;
+	}
+	SkipWhitespace();
+	if (pos == end) {
+		return false;
+	}
+	const char *str;
+	idx_t len;
+	bool escaped;
+	double value;
+	switch (*pos) {
+	case '{':
+		pos++;
+		if (Consume('}')) {
+			return true;
+		}
+		do {
+			if (!ReadString(str, len, escaped) || !Consume(':') || !SkipValue(depth + 1)) {
+				return false;
+			}
+		} while (Consume(','));
+		return Consume('}');
+	case '[':
+		pos++;
+		if (Consume(']')) {
+			return true;
+		}
+		do {
+			if (!SkipValue(depth + 1)) {
+				return false;
+			}
+		} while (Consume(','));
+		return Consume(']');
+	case '"':
+		return ReadString(str, len, escaped);
+	case 't':
+		return ConsumeLiteral("true", 4);
+	case 'f':
+		return ConsumeLiteral("false", 5);
+	case 'n':
+		return ConsumeLiteral("null", 4);
+	default:
+		return ReadNumber(value);
+	}
+}
+
+/*
+ * Read an array of the coordinates member. The numbers of a position go to the builder, padded or cut to three
+ * ordinates: parse_geojson_coord reads the first three and takes a missing Z as 0. Arrays mixing numbers and arrays,
+ * or holding anything else, are left to json-c.
+ */
+bool GeoJSONReader::ReadCoordinateArray(idx_t depth) {
+	if (depth >= GEOJSON_READER_MAX_DEPTH) {
+		return false;
+	}
+	pos++;
+	auto array = arrays.size();
+	CoordinateArray entry;
+	entry.count = 0;
+	entry.position = false;
+	entry.coords = builder.coords.size();
+	entry.end = array + 1;
+	arrays.push_back(entry);
+	if (Consume(']')) {
+		return true;
+	}
+
+	SkipWhitespace();
+	bool position = pos < end && *pos != '[';
+	uint32_t count = 0;
+	do {
+		if (position) {
+			double value;
+			if (!ReadNumber(value)) {
+				return false;
+			}
+			if (count < 3) {
+				builder.coords.push_back(value);
+			}
+		} else {
+			SkipWhitespace();
+			if (pos == end || *pos != '[' || !ReadCoordinateArray(depth + 1)) {
+				return false;
+			}
+		}
+		count++;
+	} while (Consume(','));
+	if (!Consume(']')) {
+		return false;
+	}
+	for (auto i = count; i < 3 && position; i++) {
+		builder.coords.push_back(0);
+	}
+	arrays[array].count = count;
+	arrays[array].position = position;
+	arrays[array].end = arrays.size();
+	return true;
+}
+
+/*
+ * lwgeom_from_geojson looks up crs.type and crs.properties.name, which fails on an empty object along the way. The name
+ * is not used.
+ */
+bool GeoJSONReader::ReadCrs(idx_t depth) {
+	if (depth >= GEOJSON_READER_MAX_DEPTH) {
+		return false;
+	}
+	SkipWhitespace();
+	if (pos == end || *pos != '{') {
+		return SkipValue(depth);
+	}
+	pos++;
+	if (Consume('}')) {
+		return false;
+	}
+	bool has_type = false;
+	bool has_properties = false;
+	bool empty_properties = false;
+	do {
+		const char *name;
+		idx_t len;
+		if (!ReadMemberName(name, len)) {
+			return false;
+		}
+		if (NameEquals(name, len, "type")) {
+			if (has_type) {
+				return false;
+			}
+			has_type = true;
+		} else if (NameEquals(name, len, "properties")) {
+			if (has_properties) {
+				return false;
+			}
+			has_properties = true;
+			SkipWhitespace();
+			if (pos < end && *pos == '{') {
+				auto p = pos + 1;
+				while (p < end && IsWhitespace(*p)) {
+					p++;
+				}
+				empty_properties = p < end && *p == '}';
+			}
+		}
+		if (!SkipValue(depth + 1)) {
+			return false;
+		}
+	} while (Consume(','));
+	return Consume('}') && !(has_type && empty_properties);
+}
+
+//! Read the members of a GeometryCollection; its node is added before them so the nodes stay in pre-order
+bool GeoJSONReader::ReadGeometries(idx_t depth) {
+	if (depth >= GEOJSON_READER_MAX_DEPTH) {
+		return false;
+	}
+	auto node = builder.AddNode(COLLECTIONTYPE);
+	SkipWhitespace();
+	if (pos < end && *pos == '[') {
+		pos++;
+		uint32_t count = 0;
+		if (!Consume(']')) {
+			do {
+				/* parse_geojson fails on a member that is not an object */
+				SkipWhitespace();
+				if (pos == end || *pos != '{' || !ReadGeometryObject(depth + 1, false)) {
+					return false;
+				}
+				count++;
+			} while (Consume(','));
+			if (!Consume(']')) {
+				return false;
+			}
+		}
+		builder.nodes[node].count = count;
+	} else if (ConsumeLiteral("null", 4) || !SkipValue(depth)) {
+		/* A null member is a missing one for findMemberByName; any other value gives an empty collection */
+		return false;
+	}
+
+	auto &collection = builder.nodes[node];
+	collection.end = builder.nodes.size();
+	for (auto member = node + 1; member < collection.end; member = builder.nodes[member].end) {
+		collection.empty = collection.empty && builder.nodes[member].empty;
+	}
+	return true;
+}
+
+bool GeoJSONReader::ReadGeometryObject(idx_t depth, bool top_level) {
+	if (depth >= GEOJSON_READER_MAX_DEPTH) {
+		return false;
+	}
+	pos++;
+	auto first_array = arrays.size();
+	uint8_t type = 0;
+	bool has_coordinates = false;
+	bool has_geometries = false;
+	bool has_crs = false;
+	/* findMemberByName fails on an object without members */
+	if (Consume('}')) {
+		return false;
+	}
+	/* json-c keeps the last value of a repeated member at the place of the first one, and findMemberByName takes
+	 * the first member whose name matches in any case; members that matter may only appear once here */
+	do {
+		const char *name;
+		idx_t len;
+		if (!ReadMemberName(name, len)) {
+			return false;
+		}
+		if (NameEquals(name, len, "type")) {
+			const char *type_name;
+			idx_t type_len;
+			bool escaped;
+			if (type != 0 || !ReadString(type_name, type_len, escaped) || escaped) {
+				return false;
+			}
+			type = LWTypeFromGeoJSONType(type_name, type_len);
+			if (type == 0) {
+				return false;
+			}
+		} else if (NameEquals(name, len, "coordinates")) {
+			SkipWhitespace();
+			if (has_coordinates || pos == end || *pos != '[' || !ReadCoordinateArray(depth + 1)) {
+				return false;
+			}
+			has_coordinates = true;
+		} else if (NameEquals(name, len, "geometries")) {
+			/* The members of a collection are read as they come, so its type has to be known first */
+			if (has_geometries || type == 0) {
+				return false;
+			}
+			has_geometries = true;
+			if (!(type == COLLECTIONTYPE ? ReadGeometries(depth + 1) : SkipValue(depth + 1))) {
+				return false;
+			}
+		} else if (top_level && NameEquals(name, len, "crs")) {
+			if (has_crs || !ReadCrs(depth + 1)) {
+				return false;
+			}
+			has_crs = true;
+		} else if (!SkipValue(depth + 1)) {
+			return false;
+		}
+	} while (Consume(','));
+	if (!Consume('}') || type == 0) {
+		return false;
+	}
+
+	if (type == COLLECTIONTYPE) {
+		/* The collection was added with its geometries, the coordinates are not used */
+		if (!has_geometries) {
+			return false;
+		}
+	} else if (!has_coordinates || !AddGeometry(type, first_array)) {
+		return false;
+	}
+	arrays.resize(first_array);
+	return true;
+}
+
+bool GeoJSONReader::AddPoint(idx_t array) {
+	auto &position = arrays[array];
+	/* parse_geojson_coord needs an array of at least two ordinates */
+	if (!position.position || position.count < 2) {
+		return false;
+	}
+	auto node = builder.AddNode(POINTTYPE);
+	auto &entry = builder.nodes[node];
+	entry.count = 1;
+	entry.empty = false;
+	entry.coords = position.coords;
+	has_z = has_z || position.count > 2;
+	return true;
+}
+
+//! Fill a linestring or a ring from an array of positions, which lie one after the other in the coordinates
+bool GeoJSONReader::AddPointArray(idx_t node, idx_t array) {
+	auto &points = arrays[array];
+	if (points.position) {
+		return false;
+	}
+	for (auto point = array + 1; point < points.end; point++) {
+		auto &position = arrays[point];
+		if (!position.position || position.count < 2) {
+			return false;
+		}
+		has_z = has_z || position.count > 2;
+	}
+	auto &entry = builder.nodes[node];
+	entry.count = points.count;
+	entry.empty = points.count == 0;
+	if (points.count > 0) {
+		entry.coords = arrays[array + 1].coords;
+	}
+	return true;
+}
+
+bool GeoJSONReader::AddPolygon(idx_t array) {
+	auto &rings = arrays[array];
+	if (rings.position) {
+		return false;
+	}
+	auto node = builder.AddNode(POLYGONTYPE);
+	uint32_t nrings = 0;
+	for (auto ring = array + 1; ring < rings.end; ring = arrays[ring].end) {
+		/* parse_geojson_poly_rings skips empty rings, and an empty exterior ring leaves the polygon empty */
+		if (arrays[ring].count == 0) {
+			if (ring == array + 1) {
+				break;
+			}
+			continue;
+		}
+		if (!AddPointArray(builder.AddNode(0), ring)) {
+			return false;
+		}
+		nrings++;
+	}
+	auto &entry = builder.nodes[node];
+	entry.count = nrings;
+	entry.empty = nrings == 0;
+	entry.end = builder.nodes.size();
+	return true;
+}
+
+bool GeoJSONReader::AddGeometry(uint8_t type, idx_t array) {
+	switch (type) {
+	case POINTTYPE:
+		return AddPoint(array);
+	case LINETYPE:
+		return AddPointArray(builder.AddNode(LINETYPE), array);
+	case POLYGONTYPE:
+		return AddPolygon(array);
+	default:
+		break;
+	}
+
+	auto &members = arrays[array];
+	/* Only parse_geojson_multipolygon tolerates members that are not arrays, and skips them */
+	if (members.position && type != MULTIPOLYGONTYPE) {
+		return false;
+	}
+	auto node = builder.AddNode(type);
+	if (!members.position) {
+		for (auto member = array + 1; member < members.end; member = arrays[member].end) {
+			bool success;
+			if (type == MULTIPOINTTYPE) {
+				success = AddPoint(member);
+			} else if (type == MULTILINETYPE) {
+				success = AddPointArray(builder.AddNode(LINETYPE), member);
+			} else {
+				success = AddPolygon(member);
+			}
+			if (!success) {
+				return false;
+			}
+		}
+		builder.nodes[node].count = members.count;
+	}
+	auto &collection = builder.nodes[node];
+	collection.end = builder.nodes.size();
+	for (auto member = node + 1; member < collection.end; member = builder.nodes[member].end) {
+		collection.empty = collection.empty && builder.nodes[member].empty;
+	}
+	return true;
+}
+
+bool GeoJSONReader::TryRead(const char *text, idx_t len, int32_t srid) {
+	pos = text;
+	end = text + len;
+	builder.Reset();
+	builder.srid = srid;
+	arrays.clear();
+	has_z = false;
+
+	SkipWhitespace();
+	if (pos == end || *pos != '{' || !ReadGeometryObject(0, true)) {
+		return false;
+	}
+	/* json-c stops after the object; whatever follows is left to it */
+	SkipWhitespace();
+	if (pos != end) {
+		return false;
+	}
+
+	if (has_z) {
+		/* The point arrays of liblwgeom all have a Z, 0 for the positions without a third ordinate */
+		builder.SetDimensionality(0, true, false);
+		return true;
+	}
+	/* Without any third ordinate, lwgeom_from_geojson forces the geometry to 2D, which also leaves the empty
+	 * collections without members */
+	auto &coords = builder.coords;
+	idx_t npositions = coords.size() / 3;
+	for (idx_t i = 0; i < npositions; i++) {
+		coords[i * 2] = coords[i * 3];
+		coords[i * 2 + 1] = coords[i * 3 + 1];
+	}
+	coords.resize(npositions * 2);
+	for (auto &node : builder.nodes) {
+		node.coords = node.coords / 3 * 2;
+		if (node.empty && lwtype_is_collection(node.type)) {
+			node.count = 0;
+		}
+	}
+	return true;
+}
+
+} // namespace duckdb
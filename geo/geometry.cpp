@@ -2,12 +2,17 @@
 
 #include "duckdb/common/types/vector.hpp"
 #include "postgis.hpp"
+#include "wkb-view.hpp"
 
 namespace duckdb {
 
 string Geometry::GetString(string_t geometry, DataFormatType ftype) {
-	auto data = (const_data_ptr_t)geometry.GetDataUnsafe();
-	auto len = geometry.GetSize();
+	if (geometry.GetSize() == 0) {
+		return "";
+	}
+	WKBView view(geometry);
+	auto data = view.GetData();
+	auto len = view.GetSize();
 	if (len == 0) {
 		return "";
 	}
@@ -53,6 +58,7 @@ void Geometry::ToGeometry(GSERIALIZED *gser, data_ptr_t output) {
 	data_ptr_t base = (data_ptr_t)postgis.LWGEOM_base(gser);
 	auto geometry_len = Geometry::GetGeometrySize(gser);
 	memcpy(output, base, geometry_len);
+	lwfree(base);
 }
 
 string Geometry::ToGeometry(GSERIALIZED *gser) {
@@ -69,11 +75,22 @@ string Geometry::ToGeometry(string_t text) {
 	return str;
 }
 
+string_t Geometry::ToGeometry(GSERIALIZED *gser, Vector &result) {
+	Postgis postgis;
+	return postgis.LWGEOM_base(gser, result);
+}
+
 GSERIALIZED *Geometry::GetGserialized(string_t geom) {
 	Postgis postgis;
-	auto data = (const_data_ptr_t)geom.GetDataUnsafe();
-	auto size = geom.GetSize();
-	return postgis.LWGEOM_getGserialized(data, size);
+	// skip the cached bounding box prefix, if any
+	WKBView view(geom);
+	return postgis.LWGEOM_getGserialized(view.GetData(), view.GetSize());
+}
+
+LWGEOM *Geometry::GetLWGEOM(string_t geom) {
+	Postgis postgis;
+	WKBView view(geom);
+	return postgis.LWGEOM_getLwgeom(view.GetData(), view.GetSize());
 }
 
 GSERIALIZED *Geometry::ToGserialized(string_t str) {
@@ -93,6 +110,11 @@ void Geometry::DestroyGeometry(GSERIALIZED *gser) {
 	postgis.LWGEOM_free(gser);
 }
 
+void Geometry::DestroyLWGEOM(LWGEOM *geom) {
+	Postgis postgis;
+	postgis.LWGEOM_free(geom);
+}
+
 data_ptr_t Geometry::GetBase(GSERIALIZED *gser) {
 	Postgis postgis;
 	data_ptr_t base = (data_ptr_t)postgis.LWGEOM_base(gser);
@@ -270,6 +292,44 @@ bool Geometry::GeometryDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double di
 	return postgis.LWGEOM_dwithin(geom1, geom2, distance);
 }
 
+bool Geometry::GeographyDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance, bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_dwithin(geom1, geom2, tolerance, use_spheroid);
+}
+
+bool Geometry::GeographyDWithin(const CircTreeGeomCache *cache, GSERIALIZED *geom, double tolerance,
+                                bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_dwithin_cached(cache, geom, tolerance, use_spheroid);
+}
+
+bool Geometry::GeographyDWithinBoxReject(const GBOX &box1, bool edges1, const GBOX &box2, bool edges2, int32_t srid,
+                                         double tolerance, bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_dwithin_box_reject(&box1, edges1, &box2, edges2, srid, tolerance, use_spheroid);
+}
+
+PrepGeomCache *Geometry::PrepareGeometry(GSERIALIZED *geom) {
+	Postgis postgis;
+	return postgis.GetPrepGeomCache(geom);
+}
+
+void Geometry::DestroyPreparedGeometry(PrepGeomCache *cache) {
+	Postgis postgis;
+	postgis.PrepGeomCacheFree(cache);
+}
+
+bool Geometry::GeometryPreparedPredicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate) {
+	Postgis postgis;
+	return postgis.prepared_predicate(cache, geom, predicate);
+}
+
+bool Geometry::GeometryPreparedPredicate(PrepGeomCache *cache, const POINT2D &point, int32_t srid,
+                                         PreparedPredicate predicate, bool &result) {
+	Postgis postgis;
+	return postgis.prepared_predicate_point(cache, point.x, point.y, srid, predicate, &result);
+}
+
 double Geometry::GeometryArea(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.ST_Area(geom);
@@ -308,6 +368,11 @@ double Geometry::GeometryAzimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return postgis.geography_azimuth(geom1, geom2);
 }
 
+double Geometry::GeometryAzimuth(const POINT2D &point1, const POINT2D &point2, int32_t srid) {
+	Postgis postgis;
+	return postgis.geography_azimuth(&point1, &point2, srid);
+}
+
 double Geometry::GeometryLength(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_length2d_linestring(geom);
@@ -336,12 +401,28 @@ GSERIALIZED *Geometry::GeometryExtent(GSERIALIZED *gserArray[], int nelems) {
 	return postgis.LWGEOM_envelope_garray(gserArray, nelems);
 }
 
+GSERIALIZED *Geometry::GeometryExtent(const GBOX &box, int32_t srid) {
+	Postgis postgis;
+	return postgis.LWGEOM_envelope_box(&box, srid);
+}
+
+bool Geometry::GeometryBBox(GSERIALIZED *geom, GBOX &box) {
+	Postgis postgis;
+	return postgis.LWGEOM_calculate_gbox(geom, &box);
+}
+
 std::vector<int> Geometry::GeometryClusterDBScan(GSERIALIZED *gserArray[], int nelems, double tolerance,
                                                  int minpoints) {
 	Postgis postgis;
 	return postgis.ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints);
 }
 
+std::vector<int> Geometry::GeometryClusterDBScan(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+                                                 DBSCANTaskRunner *runner) {
+	Postgis postgis;
+	return postgis.ST_ClusterDBSCAN(geoms, nelems, tolerance, minpoints, runner);
+}
+
 int Geometry::LWGEOM_dimension(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_dimension(geom);
@@ -362,6 +443,11 @@ std::string Geometry::Geometrytype(GSERIALIZED *geom) {
 	return postgis.geometry_geometrytype(geom);
 }
 
+const std::string &Geometry::Geometrytype(uint8_t type) {
+	Postgis postgis;
+	return postgis.geometry_geometrytype(type);
+}
+
 bool Geometry::IsClosed(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_isclosed(geom);
@@ -377,6 +463,11 @@ bool Geometry::IsEmpty(GSERIALIZED *geom) {
 	return postgis.LWGEOM_isempty(geom);
 }
 
+bool Geometry::IsEmpty(LWGEOM *geom) {
+	Postgis postgis;
+	return postgis.LWGEOM_isempty(geom);
+}
+
 bool Geometry::IsRing(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_isring(geom);
@@ -417,6 +508,27 @@ double Geometry::Distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
 	return postgis.geography_distance(g1, g2, use_spheroid);
 }
 
+CircTreeGeomCache *Geometry::BuildCircTree(GSERIALIZED *geom) {
+	Postgis postgis;
+	return postgis.GetCircTreeGeomCache(geom);
+}
+
+void Geometry::DestroyCircTree(CircTreeGeomCache *cache) {
+	Postgis postgis;
+	postgis.CircTreeGeomCacheFree(cache);
+}
+
+double Geometry::Distance(const CircTreeGeomCache *cache, GSERIALIZED *geom, bool use_spheroid) {
+	Postgis postgis;
+	return postgis.geography_distance_cached(cache, geom, use_spheroid);
+}
+
+void Geometry::PointDistance(const double *lon1, const double *lat1, const double *lon2, const double *lat2,
+                             idx_t count, int32_t srid, bool use_spheroid, double *result) {
+	Postgis postgis;
+	postgis.geography_distance_points(lon1, lat1, lon2, lat2, count, srid, use_spheroid, result);
+}
+
 double Geometry::XPoint(GSERIALIZED *geom) {
 	Postgis postgis;
 	return postgis.LWGEOM_x_point(geom);
@@ -12,7 +12,7 @@
 
 namespace duckdb {
 
-static const std::vector<ScalarFunctionSet> GetAccessorScalarFunctions(LogicalType geo_type) {
+static const std::vector<ScalarFunctionSet> GetAccessorScalarFunctions(LogicalType geo_type, LogicalType point_type) {
 	std::vector<ScalarFunctionSet> func_set {};
 
 	// ST_DIMENSION
@@ -86,11 +86,13 @@ static const std::vector<ScalarFunctionSet> GetAccessorScalarFunctions(LogicalTy
 	// ST_X
 	ScalarFunctionSet get_x("st_x");
 	get_x.AddFunction(ScalarFunction({geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryGetXFunction));
+	get_x.AddFunction(ScalarFunction({point_type}, LogicalType::DOUBLE, GeoFunctions::PointGetXFunction));
 	func_set.push_back(get_x);
 
 	// ST_Y
 	ScalarFunctionSet get_y("st_y");
 	get_y.AddFunction(ScalarFunction({geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryGetYFunction));
+	get_y.AddFunction(ScalarFunction({point_type}, LogicalType::DOUBLE, GeoFunctions::PointGetYFunction));
 	func_set.push_back(get_y);
 
 	return func_set;
@@ -17,6 +17,10 @@ namespace duckdb {
 struct GeoFunctions {
 	static bool CastVarcharToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
 	static bool CastGeoToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastPointToGEO(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastGeoToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastVarcharToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+	static bool CastNullToPoint(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
 	static void MakePointFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void MakeLineFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void MakeLineArrayFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -25,6 +29,9 @@ struct GeoFunctions {
 	static void GeometryAsTextFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryAsGeojsonFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeoHashFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryGeoHashIntFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryHilbertFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryZOrderFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeogFromFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryGeomFromGeoJsonFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryFromTextFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -73,9 +80,17 @@ struct GeoFunctions {
 	static void GeometryCoveredByFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryDisjointFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	//! Local state of the predicates that cache the prepared form of a constant argument
+	static unique_ptr<FunctionLocalState> InitPreparedPredicateLocalState(ExpressionState &state,
+	                                                                      const BoundFunctionExpression &expr,
+	                                                                      FunctionData *bind_data);
 
 	// **Measures (9)**
 	static void GeometryDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	//! Local state of ST_DISTANCE caching the circular tree of a repeated argument
+	static unique_ptr<FunctionLocalState> InitCircTreeLocalState(ExpressionState &state,
+	                                                             const BoundFunctionExpression &expr,
+	                                                             FunctionData *bind_data);
 	static void GeometryAreaFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryAngleFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryPerimeterFunction(DataChunk &args, ExpressionState &state, Vector &result);
@@ -84,6 +99,19 @@ struct GeoFunctions {
 	static void GeometryBoundingBoxFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryMaxDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result);
 	static void GeometryExtentFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+	// **Bounding box storage (3)**
+	static void GeometryAddBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryDropBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void GeometryHasBBoxFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+	// **GEOGRAPHY_POINT overloads (6)**
+	static void PointGetXFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointGetYFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointDistanceFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointAzimuthFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointDWithinFunction(DataChunk &args, ExpressionState &state, Vector &result);
+	static void PointEqualsFunction(DataChunk &args, ExpressionState &state, Vector &result);
 };
 
 } // namespace duckdb
@@ -8,7 +8,13 @@
 
 #pragma once
 
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "geometry.hpp"
+#include "liblwgeom/lwgeom_geos.hpp"
+#include "wkb-view.hpp"
+
+#include <condition_variable>
+#include <deque>
 
 namespace duckdb {
 
@@ -145,17 +151,164 @@ public:
 	}
 };
 
+//! Runs the batches of a parallel ST_CLUSTERDBSCAN on the task scheduler of the database, within its thread budget. The
+//! tasks only borrow idle worker threads: the calling thread works through the batches as well, and then runs the tasks
+//! no worker has picked up, which have nothing left to do by then. No thread is started, so a clustering that runs on a
+//! worker thread while the others are busy stays on that thread.
+class ClusterDBScanTaskRunner : public DBSCANTaskRunner {
+public:
+	explicit ClusterDBScanTaskRunner(TaskScheduler &scheduler) : scheduler(scheduler) {
+	}
+
+	uint32_t NumberOfThreads() override {
+		return (uint32_t)scheduler.NumberOfThreads();
+	}
+
+	void Run(uint32_t num_threads, const std::function<void()> &work) override {
+		ClusterDBScanTaskCount running(num_threads - 1);
+		auto token = scheduler.CreateProducer();
+		for (uint32_t t = 1; t < num_threads; t++) {
+			scheduler.ScheduleTask(*token, make_unique<ClusterDBScanTask>(work, running));
+		}
+		work();
+		unique_ptr<Task> task;
+		while (scheduler.GetTaskFromProducer(*token, task)) {
+			task->Execute(TaskExecutionMode::PROCESS_ALL);
+			task.reset();
+		}
+		// wait for the tasks other threads have started
+		unique_lock<mutex> guard(running.lock);
+		running.finished.wait(guard, [&] { return running.count == 0; });
+	}
+
+private:
+	//! The number of tasks that have not finished, the last task to finish wakes up the calling thread
+	struct ClusterDBScanTaskCount {
+		explicit ClusterDBScanTaskCount(uint32_t count) : count(count) {
+		}
+
+		mutex lock;
+		std::condition_variable finished;
+		uint32_t count;
+	};
+
+	class ClusterDBScanTask : public Task {
+	public:
+		ClusterDBScanTask(const std::function<void()> &work, ClusterDBScanTaskCount &running)
+		    : work(work), running(running) {
+		}
+
+		TaskExecutionResult Execute(TaskExecutionMode mode) override {
+			work();
+			// notify while holding the lock, the calling thread releases the count as soon as it sees 0
+			lock_guard<mutex> guard(running.lock);
+			if (--running.count == 0) {
+				running.finished.notify_one();
+			}
+			return TaskExecutionResult::TASK_FINISHED;
+		}
+
+	private:
+		const std::function<void()> &work;
+		ClusterDBScanTaskCount &running;
+	};
+
+	TaskScheduler &scheduler;
+};
+
+struct ClusterDBScanBindData : public FunctionData {
+	explicit ClusterDBScanBindData(TaskScheduler &scheduler) : scheduler(scheduler) {
+	}
+
+	//! The scheduler large partitions are clustered on
+	TaskScheduler &scheduler;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_unique<ClusterDBScanBindData>(scheduler);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = (const ClusterDBScanBindData &)other_p;
+		return &scheduler == &other.scheduler;
+	}
+};
+
+//! Deserialized geometries of the rows of the last clustered frame. They are kept from one frame to the next, so that
+//! a moving frame only deserializes the rows entering it instead of the whole frame.
+struct ClusterDBScanRowCache {
+	struct Row {
+		bool loaded;
+		//! nullptr for rows that are filtered out, NULL or empty
+		LWGEOM *geom;
+	};
+
+	~ClusterDBScanRowCache() {
+		Clear();
+	}
+
+	void Clear() {
+		for (auto &row : rows) {
+			Release(row);
+		}
+		rows.clear();
+	}
+
+	//! Keep the rows of [begin, end) that are already cached, rows past the cached range are appended on demand
+	void Slide(idx_t begin, idx_t end) {
+		if (begin < first || begin >= first + rows.size()) {
+			Clear();
+			first = begin;
+			return;
+		}
+		while (first < begin) {
+			Release(rows.front());
+			rows.pop_front();
+			first++;
+		}
+		while (first + rows.size() > end) {
+			Release(rows.back());
+			rows.pop_back();
+		}
+	}
+
+	//! The cached row at offset from the first row, appending not yet loaded rows as needed
+	Row &GetRow(idx_t offset) {
+		while (rows.size() <= offset) {
+			rows.push_back(Row {false, nullptr});
+		}
+		return rows[offset];
+	}
+
+	//! Index of the first cached row
+	idx_t first = 0;
+	std::deque<Row> rows;
+
+private:
+	static void Release(Row &row) {
+		if (row.geom) {
+			Geometry::DestroyLWGEOM(row.geom);
+			row.geom = nullptr;
+		}
+	}
+};
+
 struct ClusterDBScanState {
 	bool isset;
 	double epsilon;
 	int minpoints;
+	//! The frame the cluster ids were computed for
+	FrameBounds frame;
+	//! The cluster id of every row of frame, -1 for rows in no cluster
 	std::vector<int> clusters;
+	ClusterDBScanRowCache *rows;
 
 	void Initialize() {
 		this->isset = false;
 		this->epsilon = 0;
 		this->minpoints = 0;
+		this->frame = FrameBounds(0, 0);
 		this->clusters = {};
+		this->rows = nullptr;
 	}
 
 	void Combine(const ClusterDBScanState &other) {
@@ -169,9 +322,12 @@ struct ClusterDBScanState {
 struct ClusterDBScanOperation {
 	template <class STATE>
 	static void Initialize(STATE *state) {
+		state->isset = false;
 		state->clusters = {};
 		state->epsilon = 0;
 		state->minpoints = 0;
+		state->frame = FrameBounds(0, 0);
+		state->rows = nullptr;
 	}
 
 	template <class STATE, class OP>
@@ -221,30 +377,48 @@ struct ClusterDBScanOperation {
 		auto &rmask = FlatVector::Validity(result);
 		double epsilon = bdata[ridx] / MS_PER_RADIAN;
 		int minpoints = cdata[ridx];
-		if (!state->isset || frame.first != prev.first || frame.second != prev.second || state->epsilon != epsilon ||
-		    state->minpoints != minpoints) {
+		// The state lives as long as the partition. A frame covering the whole partition (no ORDER BY, or UNBOUNDED
+		// PRECEDING to UNBOUNDED FOLLOWING) is the same for every row, so the partition is clustered once and every
+		// row reads its entry. Other frames are clustered again when their bounds move.
+		if (!state->isset || frame != state->frame || state->epsilon != epsilon || state->minpoints != minpoints) {
 			state->isset = true;
 			state->epsilon = epsilon;
 			state->minpoints = minpoints;
+			state->frame = frame;
+			if (!state->rows) {
+				state->rows = new ClusterDBScanRowCache();
+			}
+			auto &cache = *state->rows;
+			cache.Slide(frame.first, frame.second);
 			size_t asize = frame.second - frame.first;
-			std::vector<GSERIALIZED *> gserArray {};
+			std::vector<LWGEOM *> geoms {};
 			std::vector<int> indexVec(asize, -1);
 			int idx = 0;
 
 			for (size_t i = frame.first; i < frame.second; i++) {
-				if (include(i)) {
-					auto gser = Geometry::GetGserialized(adata[i]);
-					if (!Geometry::IsEmpty(gser)) {
-						gserArray.push_back(gser);
-						indexVec[i - frame.first] = idx++;
-					} else {
-						Geometry::DestroyGeometry(gser);
+				// only the rows that were not in the previous frame get deserialized
+				auto &row = cache.GetRow(i - frame.first);
+				if (!row.loaded) {
+					row.loaded = true;
+					if (include(i) && adata[i].GetSize() > 0) {
+						auto geom = Geometry::GetLWGEOM(adata[i]);
+						if (geom && !Geometry::IsEmpty(geom)) {
+							row.geom = geom;
+						} else if (geom) {
+							Geometry::DestroyLWGEOM(geom);
+						}
 					}
 				}
+				if (row.geom) {
+					geoms.push_back(row.geom);
+					indexVec[i - frame.first] = idx++;
+				}
 			}
 
 			// Doing cluster db scan
-			auto clusters = Geometry::GeometryClusterDBScan(&gserArray[0], gserArray.size(), epsilon, minpoints);
+			auto &bind_data = (ClusterDBScanBindData &)*aggr_input_data.bind_data;
+			ClusterDBScanTaskRunner runner(bind_data.scheduler);
+			auto clusters = Geometry::GeometryClusterDBScan(geoms.data(), geoms.size(), epsilon, minpoints, &runner);
 
 			state->clusters = {};
 
@@ -255,28 +429,21 @@ struct ClusterDBScanOperation {
 					state->clusters.push_back(clusters[indexVec[i]]);
 				}
 			}
+		}
 
-			// Free memory
-			for (idx_t child_idx = 0; child_idx < gserArray.size(); child_idx++) {
-				Geometry::DestroyGeometry(gserArray[child_idx]);
-			}
-
-			if (state->clusters[ridx - frame.first] == -1) {
-				rmask.SetInvalid(ridx);
-			} else {
-				rdata[ridx] = state->clusters[ridx - frame.first];
-			}
+		if (state->clusters[ridx - frame.first] == -1) {
+			rmask.SetInvalid(ridx);
 		} else {
-			if (state->clusters[ridx - frame.first] == -1) {
-				rmask.SetInvalid(ridx);
-			} else {
-				rdata[ridx] = state->clusters[ridx - frame.first];
-			}
+			rdata[ridx] = state->clusters[ridx - frame.first];
 		}
 	}
 
 	template <class STATE>
 	static void Destroy(STATE *state) {
+		if (state->rows) {
+			delete state->rows;
+			state->rows = nullptr;
+		}
 	}
 };
 
@@ -321,7 +488,7 @@ unique_ptr<FunctionData> BindGeometryClusterDBScan(ClientContext &context, Aggre
 	                      TernaryWindow<ClusterDBScanState, string_t, double, int, int, ClusterDBScanOperation>);
 	function.name = "st_clusterdbscan";
 	function.arguments[0] = geo_type;
-	return nullptr;
+	return make_unique<ClusterDBScanBindData>(TaskScheduler::GetScheduler(context));
 }
 
 static const AggregateFunctionSet GetClusterDBScanAggregateFunction(LogicalType geo_type) {
@@ -334,4 +501,251 @@ static const AggregateFunctionSet GetClusterDBScanAggregateFunction(LogicalType
 	return cluster_dbscan;
 }
 
+struct ExtentAggState {
+	bool isset;
+	int32_t srid;
+	double xmin;
+	double ymin;
+	double xmax;
+	double ymax;
+};
+
+struct ExtentAggOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->isset = false;
+		state->srid = SRID_UNKNOWN;
+		state->xmin = state->ymin = state->xmax = state->ymax = 0;
+	}
+
+	template <class STATE>
+	static void AddBox(STATE *state, int32_t srid, double xmin, double ymin, double xmax, double ymax) {
+		if (!state->isset) {
+			state->isset = true;
+			state->srid = srid;
+			state->xmin = xmin;
+			state->ymin = ymin;
+			state->xmax = xmax;
+			state->ymax = ymax;
+			return;
+		}
+		if (state->srid != srid) {
+			throw ConversionException("Failure in geometry extent: operation on mixed SRID geometries (%d != %d)",
+			                          state->srid, srid);
+		}
+		state->xmin = MinValue(state->xmin, xmin);
+		state->ymin = MinValue(state->ymin, ymin);
+		state->xmax = MaxValue(state->xmax, xmax);
+		state->ymax = MaxValue(state->ymax, ymax);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto &geom = input[idx];
+		if (geom.GetSize() == 0) {
+			return;
+		}
+		WKBView view(geom);
+		GBOX box;
+		if (view.IsValid() && view.TryGetBBox(box)) {
+			if (box.xmin > box.xmax) {
+				// empty geometries do not contribute to the extent
+				return;
+			}
+		} else {
+			// curves go through liblwgeom, which also raises the ST_EXTENT error on malformed values
+			auto gser = Geometry::GetGserialized(geom);
+			if (!gser) {
+				return;
+			}
+			bool has_box = Geometry::GeometryBBox(gser, box);
+			Geometry::DestroyGeometry(gser);
+			if (!has_box) {
+				return;
+			}
+		}
+		AddBox(state, view.GetSRID(), box.xmin, box.ymin, box.xmax, box.ymax);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		// the extent of a repeated geometry is the extent of the geometry itself
+		Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		if (!source.isset) {
+			return;
+		}
+		AddBox(target, source.srid, source.xmin, source.ymin, source.xmax, source.ymax);
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		if (!state->isset) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		GBOX box;
+		box.flags = 0;
+		box.xmin = state->xmin;
+		box.ymin = state->ymin;
+		box.xmax = state->xmax;
+		box.ymax = state->ymax;
+		auto gser = Geometry::GeometryExtent(box, state->srid);
+		if (!gser) {
+			throw ConversionException("Failure in geometry extent: could not calculate the extent");
+		}
+		target[idx] = Geometry::ToGeometry(gser, result);
+		Geometry::DestroyGeometry(gser);
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static const AggregateFunctionSet GetExtentAggAggregateFunction(LogicalType geo_type) {
+	// ST_EXTENT_AGG
+	AggregateFunctionSet extent_agg("st_extent_agg");
+	extent_agg.AddFunction(
+	    AggregateFunction::UnaryAggregate<ExtentAggState, string_t, string_t, ExtentAggOperation>(geo_type, geo_type));
+
+	return extent_agg;
+}
+
+//! Number of geometries buffered by ST_UNION_AGG before they are merged into the partial union
+static constexpr const idx_t UNION_AGG_BATCH_SIZE = 1024;
+
+struct UnionAggState {
+	//! Union of every geometry flushed so far
+	GSERIALIZED *partial;
+	//! Geometries waiting for the next cascaded union
+	std::vector<GSERIALIZED *> *pending;
+};
+
+struct UnionAggOperation {
+	template <class STATE>
+	static void Initialize(STATE *state) {
+		state->partial = nullptr;
+		state->pending = nullptr;
+	}
+
+	static GSERIALIZED *CopyGeometry(const GSERIALIZED *gser) {
+		auto size = LWSIZE_GET(gser->size);
+		auto copy = (GSERIALIZED *)lwalloc(size);
+		memcpy(copy, gser, size);
+		return copy;
+	}
+
+	//! Run one cascaded union over the partial result and the pending batch
+	template <class STATE>
+	static void Flush(STATE *state) {
+		if (!state->pending || state->pending->empty()) {
+			return;
+		}
+		auto &pending = *state->pending;
+		if (state->partial) {
+			pending.push_back(state->partial);
+			state->partial = nullptr;
+		}
+		if (pending.size() == 1) {
+			state->partial = pending[0];
+			pending.clear();
+			return;
+		}
+		auto gser = Geometry::GeometryUnionGArray(&pending[0], pending.size());
+		for (auto &geom : pending) {
+			Geometry::DestroyGeometry(geom);
+		}
+		pending.clear();
+		state->partial = gser;
+	}
+
+	template <class STATE>
+	static void AddGeometry(STATE *state, GSERIALIZED *gser) {
+		if (!state->pending) {
+			state->pending = new std::vector<GSERIALIZED *>();
+		}
+		state->pending->push_back(gser);
+		if (state->pending->size() >= UNION_AGG_BATCH_SIZE) {
+			Flush(state);
+		}
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, AggregateInputData &, INPUT_TYPE *input, ValidityMask &mask, idx_t idx) {
+		auto &geom = input[idx];
+		if (geom.GetSize() == 0) {
+			return;
+		}
+		auto gser = Geometry::GetGserialized(geom);
+		if (!gser) {
+			return;
+		}
+		AddGeometry(state, gser);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, AggregateInputData &aggr_input_data, INPUT_TYPE *input,
+	                              ValidityMask &mask, idx_t count) {
+		// the union of a repeated geometry is the geometry itself
+		Operation<INPUT_TYPE, STATE, OP>(state, aggr_input_data, input, mask, 0);
+	}
+
+	template <class STATE, class OP>
+	static void Combine(const STATE &source, STATE *target, AggregateInputData &aggr_input_data) {
+		// the source state is destroyed by DuckDB afterwards, so its geometries are copied over
+		if (source.partial) {
+			AddGeometry(target, CopyGeometry(source.partial));
+		}
+		if (source.pending) {
+			for (auto &geom : *source.pending) {
+				AddGeometry(target, CopyGeometry(geom));
+			}
+		}
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, AggregateInputData &, STATE *state, T *target, ValidityMask &mask, idx_t idx) {
+		Flush(state);
+		if (!state->partial) {
+			mask.SetInvalid(idx);
+			return;
+		}
+		target[idx] = Geometry::ToGeometry(state->partial, result);
+	}
+
+	template <class STATE>
+	static void Destroy(STATE *state) {
+		if (state->partial) {
+			Geometry::DestroyGeometry(state->partial);
+			state->partial = nullptr;
+		}
+		if (state->pending) {
+			for (auto &geom : *state->pending) {
+				Geometry::DestroyGeometry(geom);
+			}
+			delete state->pending;
+			state->pending = nullptr;
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static const AggregateFunctionSet GetUnionAggAggregateFunction(LogicalType geo_type) {
+	// ST_UNION_AGG
+	AggregateFunctionSet union_agg("st_union_agg");
+	union_agg.AddFunction(
+	    AggregateFunction::UnaryAggregateDestructor<UnionAggState, string_t, string_t, UnionAggOperation>(geo_type,
+	                                                                                                      geo_type));
+
+	return union_agg;
+}
+
 } // namespace duckdb
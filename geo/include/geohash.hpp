@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// geohash.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+//! Bits of each axis in an integer GeoHash, which holds the first 64 bits of the GeoHash bit string
+#define GEOHASH_AXIS_BITS 32
+//! Number of characters of a GeoHash that an integer GeoHash determines entirely (60 of its 64 bits)
+#define GEOHASH_INTEGER_CHARS 12
+
+//! The GeoHash class encodes and decodes GeoHashes on integers instead of bisecting one bit at a time as
+//! geohash_point and decode_geohash_bbox do. A coordinate is quantized to the cell the bisection reaches after
+//! GEOHASH_AXIS_BITS steps, which is exact because every bisection midpoint up to that depth is a double, and the two
+//! cell numbers are interleaved with shifts and masks. The text and boxes are the ones liblwgeom computes: past the
+//! first GEOHASH_INTEGER_CHARS characters, the bisection continues from the cell reached so far.
+class GeoHash {
+public:
+	//! Cell of a longitude in [-180, 180] after GEOHASH_AXIS_BITS steps of the bisection of geohash_point
+	static uint32_t QuantizeLongitude(double lon);
+	//! Cell of a latitude in [-90, 90] after GEOHASH_AXIS_BITS steps of the bisection of geohash_point
+	static uint32_t QuantizeLatitude(double lat);
+
+	//! Interleave the bits of two cells, starting with the most significant bit of lon as GeoHash does
+	static inline uint64_t Interleave(uint32_t lon, uint32_t lat) {
+		return (SpreadBits(lon) << 1) | SpreadBits(lat);
+	}
+	//! Split an interleaved integer back into its two cells
+	static inline void Deinterleave(uint64_t hash, uint32_t &lon, uint32_t &lat) {
+		lon = CompactBits(hash >> 1);
+		lat = CompactBits(hash);
+	}
+
+	//! Whether a bounding box lies in the range GeoHash covers; lwgeom_geohash raises an error for the others
+	static bool IsInRange(const GBOX &box);
+	//! The point lwgeom_geohash hashes for a geometry: the center of its bounding box
+	static void BoxCenter(const GBOX &box, double &lon, double &lat);
+	//! The precision lwgeom_geohash picks when none is given, the length of the longest GeoHash whose cell holds box
+	static int BoxPrecision(const GBOX &box);
+
+	//! Compute the integer GeoHash of count points given as coordinate columns, in one loop over the chunk
+	static void Encode(const double *lon, const double *lat, idx_t count, uint64_t *result);
+	//! Write the first precision characters of the GeoHash of a point into target. The text is the one geohash_point
+	//! writes.
+	static void WriteText(double lon, double lat, idx_t precision, char *target);
+	//! Decode the bounding box of a GeoHash as decode_geohash_bbox does: the text stops at its first NUL character and
+	//! a negative precision reads all of it. Returns false for an invalid character.
+	static bool TryDecodeBBox(const char *hash, idx_t size, int precision, GBOX &result);
+	//! The point ST_POINTFROMGEOHASH returns for a decoded box: the centroid GEOS computes for its envelope
+	static void EnvelopeCentroid(const GBOX &box, double &x, double &y);
+
+private:
+	//! Move bit i of value to bit 2 * i
+	static inline uint64_t SpreadBits(uint32_t value) {
+		uint64_t x = value;
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+		x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+		x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		x = (x | (x << 2)) & 0x3333333333333333ULL;
+		x = (x | (x << 1)) & 0x5555555555555555ULL;
+		return x;
+	}
+	//! Move bit 2 * i of value to bit i, the inverse of SpreadBits
+	static inline uint32_t CompactBits(uint64_t x) {
+		x &= 0x5555555555555555ULL;
+		x = (x | (x >> 1)) & 0x3333333333333333ULL;
+		x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+		x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+		x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+		x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+		return (uint32_t)x;
+	}
+};
+
+} // namespace duckdb
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// geojson-reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "wkb-builder.hpp"
+
+namespace duckdb {
+
+//! The GeoJSONReader class is a single-pass, reentrant reader for the GeoJSON geometries accepted by
+//! lwgeom_from_geojson. It tokenizes the text in place and reads the coordinates straight into the buffers of a
+//! WKBBuilder, without building a json_object tree or an LWGEOM, so a large document costs no allocation per JSON
+//! value. The buffers are reused across rows.
+//! TryRead returns false for anything it does not handle: invalid JSON, the extensions json-c tolerates (comments,
+//! single quotes, NaN, trailing commas, leading zeros), escaped or repeated member names, values nested deeper than
+//! json-c allows, and GeoJSON that liblwgeom rejects. The caller then falls back to lwgeom_from_geojson, which raises
+//! the usual errors, so the accepted input and the resulting bytes are exactly the ones of the json-c path.
+class GeoJSONReader {
+public:
+	//! Read text as a GeoJSON geometry with the given SRID; like liblwgeom, the reader does not use the crs member
+	bool TryRead(const char *text, idx_t len, int32_t srid);
+	//! Size of the EWKB of the last geometry read
+	idx_t GetWKBSize() const {
+		return builder.GetWKBSize();
+	}
+	//! Write the EWKB of the last geometry read into target, which must hold GetWKBSize bytes. The bytes are the ones
+	//! lwgeom_to_wkb writes with WKB_EXTENDED.
+	void WriteWKB(data_ptr_t target) const {
+		builder.WriteWKB(target);
+	}
+
+private:
+	//! A JSON array of a coordinates member, in pre-order like the nodes of the builder
+	struct CoordinateArray {
+		//! Number of elements
+		uint32_t count;
+		//! Whether the elements are numbers rather than arrays
+		bool position;
+		//! Offset of the first position in the coordinates of the builder, which holds three ordinates per position
+		idx_t coords;
+		//! Index of the array following the last descendant of this one
+		idx_t end;
+	};
+
+	const char *pos;
+	const char *end;
+	WKBBuilder builder;
+	//! The coordinates members of the geometry objects being read
+	vector<CoordinateArray> arrays;
+	//! Whether a position of the geometry has a third ordinate
+	bool has_z;
+
+	bool ReadGeometryObject(idx_t depth, bool top_level);
+	bool ReadGeometries(idx_t depth);
+	bool ReadCoordinateArray(idx_t depth);
+	bool ReadCrs(idx_t depth);
+	bool SkipValue(idx_t depth);
+
+	bool AddGeometry(uint8_t type, idx_t array);
+	bool AddPoint(idx_t array);
+	bool AddPointArray(idx_t node, idx_t array);
+	bool AddPolygon(idx_t array);
+
+	void SkipWhitespace();
+	bool Consume(char c);
+	bool ConsumeLiteral(const char *literal, idx_t len);
+	bool ReadString(const char *&str, idx_t &len, bool &escaped);
+	bool ReadMemberName(const char *&name, idx_t &len);
+	bool ReadNumber(double &result);
+};
+
+} // namespace duckdb
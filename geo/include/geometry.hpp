@@ -11,9 +11,13 @@
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/types.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "postgis/geography_measurement_trees.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
 
 namespace duckdb {
 
+class DBSCANTaskRunner;
+
 enum class DataFormatType : uint8_t { FORMAT_VALUE_TYPE_WKB, FORMAT_VALUE_TYPE_WKT, FORMAT_VALUE_TYPE_GEOJSON };
 
 //! The Geometry class is a static class that holds helper functions for the Geometry type.
@@ -26,6 +30,8 @@ public:
 	static string ToString(string_t geometry, DataFormatType ftype = DataFormatType::FORMAT_VALUE_TYPE_WKB);
 
 	static GSERIALIZED *GetGserialized(string_t geom);
+	//! Deserialize a geometry straight from its WKB, for callers that keep the LWGEOM around
+	static LWGEOM *GetLWGEOM(string_t geom);
 
 	//! Convert a string to a geometry. This function should ONLY be called after calling GetGeometrySize, since it does
 	//! NOT perform data validation.
@@ -33,12 +39,15 @@ public:
 	//! Convert a string object to a geometry
 	static string ToGeometry(GSERIALIZED *gser);
 	static string ToGeometry(string_t text);
+	//! Serialize a geometry straight into the string heap of the result vector
+	static string_t ToGeometry(GSERIALIZED *gser, Vector &result);
 
 	static GSERIALIZED *ToGserialized(string_t str);
 
 	static idx_t GetGeometrySize(GSERIALIZED *gser);
 
 	static void DestroyGeometry(GSERIALIZED *gser);
+	static void DestroyLWGEOM(LWGEOM *geom);
 
 	static data_ptr_t GetBase(GSERIALIZED *gser);
 
@@ -83,6 +92,22 @@ public:
 	static bool GeometryCoveredby(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	static bool GeometryDisjoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	static bool GeometryDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance);
+	//! Geodetic ST_DWithin, tolerance in meters
+	static bool GeographyDWithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance, bool use_spheroid);
+	static bool GeographyDWithin(const CircTreeGeomCache *cache, GSERIALIZED *geom, double tolerance,
+	                             bool use_spheroid);
+	//! True if two geographies of the given vertex boxes are certainly further apart than tolerance meters
+	static bool GeographyDWithinBoxReject(const GBOX &box1, bool edges1, const GBOX &box2, bool edges2, int32_t srid,
+	                                      double tolerance, bool use_spheroid);
+	//! Deserialize and prepare a constant predicate argument once; takes ownership of geom
+	static PrepGeomCache *PrepareGeometry(GSERIALIZED *geom);
+	static void DestroyPreparedGeometry(PrepGeomCache *cache);
+	//! Evaluate "predicate(prepared, geom)"
+	static bool GeometryPreparedPredicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate);
+	//! Evaluate "predicate(prepared, point)" without building the point, returns false if the point needs the
+	//! GSERIALIZED path
+	static bool GeometryPreparedPredicate(PrepGeomCache *cache, const POINT2D &point, int32_t srid,
+	                                      PreparedPredicate predicate, bool &result);
 
 	static double GeometryArea(GSERIALIZED *geom);
 	static double GeometryArea(GSERIALIZED *geom, bool use_spheroid);
@@ -91,24 +116,43 @@ public:
 	static double GeometryPerimeter(GSERIALIZED *geom);
 	static double GeometryPerimeter(GSERIALIZED *geom, bool use_spheroid);
 	static double GeometryAzimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
+	static double GeometryAzimuth(const POINT2D &point1, const POINT2D &point2, int32_t srid);
 	static double GeometryLength(GSERIALIZED *geom);
 	static double GeometryLength(GSERIALIZED *geom, bool use_spheroid);
 	static GSERIALIZED *GeometryBoundingBox(GSERIALIZED *geom);
 	static double Distance(GSERIALIZED *g1, GSERIALIZED *g2);
 	static double Distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid);
+	//! Build the circular tree of a distance argument that repeats across rows; takes ownership of geom
+	static CircTreeGeomCache *BuildCircTree(GSERIALIZED *geom);
+	static void DestroyCircTree(CircTreeGeomCache *cache);
+	//! Geography distance between the cached geometry and geom
+	static double Distance(const CircTreeGeomCache *cache, GSERIALIZED *geom, bool use_spheroid);
+	//! Geography distance of count pairs of points given as coordinate columns
+	static void PointDistance(const double *lon1, const double *lat1, const double *lon2, const double *lat2,
+	                          idx_t count, int32_t srid, bool use_spheroid, double *result);
 	static double MaxDistance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid = true);
 	static GSERIALIZED *GeometryExtent(GSERIALIZED *gserArray[], int nelems);
+	//! Build the envelope (POINT, LINESTRING or POLYGON) of a 2D bounding box
+	static GSERIALIZED *GeometryExtent(const GBOX &box, int32_t srid);
+	//! Compute the 2D bounding box of a geometry, returns false if the geometry is empty
+	static bool GeometryBBox(GSERIALIZED *geom, GBOX &box);
 
 	static std::vector<int> GeometryClusterDBScan(GSERIALIZED *gserArray[], int nelems, double tolerance,
 	                                              int minpoints);
+	//! Cluster geometries that are already deserialized, on the threads of runner for large inputs
+	static std::vector<int> GeometryClusterDBScan(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+	                                              DBSCANTaskRunner *runner = nullptr);
 
 	static int LWGEOM_dimension(GSERIALIZED *geom);
 	static std::vector<GSERIALIZED *> LWGEOM_dump(GSERIALIZED *geom);
 	static GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
 	static std::string Geometrytype(GSERIALIZED *geom);
+	//! Name of a liblwgeom type, as returned by ST_GeometryType
+	static const std::string &Geometrytype(uint8_t type);
 	static bool IsClosed(GSERIALIZED *geom);
 	static bool IsCollection(GSERIALIZED *geom);
 	static bool IsEmpty(GSERIALIZED *geom);
+	static bool IsEmpty(LWGEOM *geom);
 	static bool IsRing(GSERIALIZED *geom);
 	static int NPoints(GSERIALIZED *geom);
 	static int NumGeometries(GSERIALIZED *geom);
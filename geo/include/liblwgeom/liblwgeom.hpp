@@ -887,6 +887,7 @@ extern double lwgeom_distance_spheroid(const LWGEOM *lwgeom1, const LWGEOM *lwge
  * Calculate the bearing between two points on a spheroid.
  */
 extern double lwgeom_azumith_spheroid(const LWPOINT *r, const LWPOINT *s, const SPHEROID *spheroid);
+extern double lw_azimuth_spheroid_2d(const POINT2D *r, const POINT2D *s, const SPHEROID *spheroid);
 
 /**
  * Calculate the geodetic area of a lwgeom on the sphere. The result
@@ -1326,6 +1327,7 @@ extern uint32_t lwtype_get_collectiontype(uint8_t type);
  */
 extern uint8_t *lwgeom_to_wkb_buffer(const LWGEOM *geom, uint8_t variant);
 extern size_t lwgeom_to_wkb_size(const LWGEOM *geom, uint8_t variant);
+extern ptrdiff_t lwgeom_to_wkb_write_buf(const LWGEOM *geom, uint8_t variant, uint8_t *buffer);
 
 /* Memory management */
 extern void *lwalloc(size_t size);
@@ -29,6 +29,8 @@
 #include "liblwgeom/liblwgeom.hpp"
 #include "liblwgeom/lwunionfind.hpp"
 
+#include <functional>
+
 namespace duckdb {
 
 /*
@@ -42,7 +44,23 @@ POINTARRAY *ptarray_from_GEOSCoordSeq(const GEOSCoordSequence *cs, uint8_t want3
 GEOSGeometry *make_geos_point(double x, double y);
 GEOSGeometry *make_geos_segment(double x1, double y1, double x2, double y2);
 
+/*
+ * Threads the parallel DBSCAN may use, provided by the caller so that the clustering shares
+ * the threads of the database instead of starting its own.
+ */
+class DBSCANTaskRunner {
+public:
+	virtual ~DBSCANTaskRunner() {
+	}
+	/* Upper bound of the number of threads Run may use, the calling one included */
+	virtual uint32_t NumberOfThreads() = 0;
+	/* Call work from up to num_threads threads, the calling one included, and return once
+	 * every call has returned. work never throws. */
+	virtual void Run(uint32_t num_threads, const std::function<void()> &work) = 0;
+};
+
+/* runner may be NULL, the clustering then runs on the calling thread only */
 int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
-                 char **is_in_cluster_ret);
+                 char **is_in_cluster_ret, DBSCANTaskRunner *runner = NULL);
 
 } // namespace duckdb
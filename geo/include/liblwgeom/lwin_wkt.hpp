@@ -44,7 +44,7 @@ typedef struct {
 /*
  * Global that holds the final output geometry for the WKT parser.
  */
-extern LWGEOM_PARSER_RESULT global_parser_result;
+extern thread_local LWGEOM_PARSER_RESULT global_parser_result;
 extern const char *parser_error_messages[];
 
 /*
@@ -24,6 +24,8 @@
 
 #include "liblwgeom/liblwgeom.hpp"
 
+#include <atomic>
+
 namespace duckdb {
 
 #ifndef _LWUNIONFIND
@@ -58,6 +60,30 @@ uint32_t *UF_ordered_by_cluster(UNIONFIND *uf);
  * */
 uint32_t *UF_get_collapsed_cluster_ids(UNIONFIND *uf, const char *is_in_cluster);
 
+/* Union-find that any number of threads can update at the same time. Roots are
+ * only ever linked under a smaller root with a compare-and-swap, so the root of
+ * a cluster is its smallest component id whatever the order of the unions. */
+typedef struct {
+	std::atomic<uint32_t> *parents;
+	uint32_t N;
+} UNIONFIND_CONCURRENT;
+
+/* Allocate a UNIONFIND_CONCURRENT structure of capacity N */
+UNIONFIND_CONCURRENT *UF_concurrent_create(uint32_t N);
+
+/* Release memory associated with UNIONFIND_CONCURRENT structure */
+void UF_concurrent_destroy(UNIONFIND_CONCURRENT *uf);
+
+/* Identify the cluster id associated with specified component id, halving the path on the way */
+uint32_t UF_concurrent_find(UNIONFIND_CONCURRENT *uf, uint32_t i);
+
+/* Merge the clusters that contain the two specified component ids */
+void UF_concurrent_union(UNIONFIND_CONCURRENT *uf, uint32_t i, uint32_t j);
+
+/* Merge the clusters of a UNIONFIND_CONCURRENT into a UNIONFIND of the same capacity,
+ * once no thread updates it any more */
+void UF_concurrent_collect(UNIONFIND_CONCURRENT *cuf, UNIONFIND *uf);
+
 #endif /* !defined _LWUNIONFIND  */
 
 } // namespace duckdb
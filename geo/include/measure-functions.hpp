@@ -12,7 +12,7 @@
 
 namespace duckdb {
 
-static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalType geo_type) {
+static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalType geo_type, LogicalType point_type) {
 	std::vector<ScalarFunctionSet> func_set {};
 
 	// ST_ANGLE
@@ -35,6 +35,8 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 	ScalarFunctionSet azimuth("st_azimuth");
 	azimuth.AddFunction(
 	    ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryAzimuthFunction));
+	azimuth.AddFunction(
+	    ScalarFunction({point_type, point_type}, LogicalType::DOUBLE, GeoFunctions::PointAzimuthFunction));
 	func_set.push_back(azimuth);
 
 	// ST_BOUNDINGBOX (ALIAS: ST_ENVELOPE)
@@ -52,12 +54,33 @@ static const std::vector<ScalarFunctionSet> GetMeasureScalarFunctions(LogicalTyp
 	extent.AddFunction(ScalarFunction({LogicalType::LIST(geo_type)}, geo_type, GeoFunctions::GeometryExtentFunction));
 	func_set.push_back(extent);
 
+	// ST_ADDBBOX
+	ScalarFunctionSet addbbox("st_addbbox");
+	addbbox.AddFunction(ScalarFunction({geo_type}, geo_type, GeoFunctions::GeometryAddBBoxFunction));
+	func_set.push_back(addbbox);
+
+	// ST_DROPBBOX
+	ScalarFunctionSet dropbbox("st_dropbbox");
+	dropbbox.AddFunction(ScalarFunction({geo_type}, geo_type, GeoFunctions::GeometryDropBBoxFunction));
+	func_set.push_back(dropbbox);
+
+	// ST_HASBBOX
+	ScalarFunctionSet hasbbox("st_hasbbox");
+	hasbbox.AddFunction(ScalarFunction({geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryHasBBoxFunction));
+	func_set.push_back(hasbbox);
+
 	// ST_DISTANCE
 	ScalarFunctionSet distance("st_distance");
-	distance.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE, GeoFunctions::GeometryDistanceFunction));
+	distance.AddFunction(ScalarFunction({geo_type, geo_type}, LogicalType::DOUBLE,
+	                                    GeoFunctions::GeometryDistanceFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitCircTreeLocalState));
 	distance.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE,
-	                                    GeoFunctions::GeometryDistanceFunction));
+	                                    GeoFunctions::GeometryDistanceFunction, nullptr, nullptr, nullptr,
+	                                    GeoFunctions::InitCircTreeLocalState));
+	distance.AddFunction(
+	    ScalarFunction({point_type, point_type}, LogicalType::DOUBLE, GeoFunctions::PointDistanceFunction));
+	distance.AddFunction(ScalarFunction({point_type, point_type, LogicalType::BOOLEAN}, LogicalType::DOUBLE,
+	                                    GeoFunctions::PointDistanceFunction));
 	func_set.push_back(distance);
 
 	// ST_LENGTH
@@ -112,7 +112,7 @@ typedef union YYSTYPE
 # define YYSTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYSTYPE  wkt_yylval;
+extern thread_local YYSTYPE  wkt_yylval;
 
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
 typedef struct YYLTYPE
@@ -127,6 +127,6 @@ typedef struct YYLTYPE
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYLTYPE  wkt_yylloc;
+extern thread_local YYLTYPE  wkt_yylloc;
 
 } // namespace duckdb
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "duckdb/common/constants.hpp"
+#include "duckdb/common/types.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "postgis/geography_measurement_trees.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
 
 #include <iostream>
 #include <string>
@@ -9,6 +12,8 @@
 
 namespace duckdb {
 
+class DBSCANTaskRunner;
+
 class Postgis {
 public:
 	Postgis();
@@ -17,8 +22,10 @@ public:
 public:
 	GSERIALIZED *LWGEOM_in(char *input);
 	GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size);
+	LWGEOM *LWGEOM_getLwgeom(const void *base, size_t size);
 	idx_t LWGEOM_size(GSERIALIZED *gser);
 	char *LWGEOM_base(GSERIALIZED *gser);
+	string_t LWGEOM_base(GSERIALIZED *gser, Vector &result);
 	string LWGEOM_asBinary(const void *data, size_t size);
 	lwvarlena_t *LWGEOM_asBinary(GSERIALIZED *gser, string text = "");
 	string LWGEOM_asText(GSERIALIZED *gser, size_t max_digits = OUT_DEFAULT_DECIMAL_DIGITS);
@@ -26,6 +33,7 @@ public:
 	string LWGEOM_asGeoJson(const void *data, size_t size);
 	lwvarlena_t *ST_GeoHash(GSERIALIZED *gser, size_t m_chars = 0);
 	void LWGEOM_free(GSERIALIZED *gser);
+	void LWGEOM_free(LWGEOM *lwgeom);
 
 	GSERIALIZED *LWGEOM_makepoint(double x, double y);
 	GSERIALIZED *LWGEOM_makepoint(double x, double y, double z);
@@ -57,6 +65,16 @@ public:
 	bool coveredby(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	bool disjoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double distance);
+	bool geography_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance, bool use_spheroid);
+	bool geography_dwithin_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, double tolerance,
+	                              bool use_spheroid);
+	bool geography_dwithin_box_reject(const GBOX *box1, bool edges1, const GBOX *box2, bool edges2, int32_t srid,
+	                                  double tolerance, bool use_spheroid);
+	PrepGeomCache *GetPrepGeomCache(GSERIALIZED *geom);
+	void PrepGeomCacheFree(PrepGeomCache *cache);
+	bool prepared_predicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate);
+	bool prepared_predicate_point(PrepGeomCache *cache, double x, double y, int32_t srid, PreparedPredicate predicate,
+	                              bool *result);
 
 	double ST_Area(GSERIALIZED *geom);
 	double geography_area(GSERIALIZED *geom, bool use_spheroid);
@@ -66,22 +84,29 @@ public:
 	double geography_perimeter(GSERIALIZED *geom, bool use_spheroid);
 	double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	double geography_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
+	double geography_azimuth(const POINT2D *point1, const POINT2D *point2, int32_t srid);
 	double LWGEOM_length2d_linestring(GSERIALIZED *geom);
 	double geography_length(GSERIALIZED *geom, bool use_spheroid);
 	GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom);
+	GSERIALIZED *LWGEOM_envelope_box(const GBOX *box, int32_t srid);
+	bool LWGEOM_calculate_gbox(GSERIALIZED *geom, GBOX *box);
 	double LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	double geography_maxdistance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
 	GSERIALIZED *LWGEOM_envelope_garray(GSERIALIZED *gserArray[], int nelems);
 
 	std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints);
+	std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+	                                  DBSCANTaskRunner *runner = nullptr);
 
 	int LWGEOM_dimension(GSERIALIZED *geom);
 	std::vector<GSERIALIZED *> LWGEOM_dump(GSERIALIZED *geom);
 	GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
 	std::string geometry_geometrytype(GSERIALIZED *geom);
+	const std::string &geometry_geometrytype(uint8_t type);
 	bool LWGEOM_isclosed(GSERIALIZED *geom);
 	bool ST_IsCollection(GSERIALIZED *geom);
 	bool LWGEOM_isempty(GSERIALIZED *geom);
+	bool LWGEOM_isempty(LWGEOM *lwgeom);
 	bool LWGEOM_isring(GSERIALIZED *geom);
 	int LWGEOM_npoints(GSERIALIZED *geom);
 	int LWGEOM_numgeometries_collection(GSERIALIZED *geom);
@@ -93,6 +118,11 @@ public:
 
 	double ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2);
 	double geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
+	CircTreeGeomCache *GetCircTreeGeomCache(GSERIALIZED *geom);
+	void CircTreeGeomCacheFree(CircTreeGeomCache *cache);
+	double geography_distance_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, bool use_spheroid);
+	void geography_distance_points(const double *lon1, const double *lat1, const double *lon2, const double *lat2,
+	                               size_t count, int32_t srid, bool use_spheroid, double *distances);
 	GSERIALIZED *centroid(GSERIALIZED *geom);
 	GSERIALIZED *geography_centroid(GSERIALIZED *geom, bool use_spheroid);
 };
@@ -26,6 +26,7 @@
 #include "duckdb.hpp"
 #include "liblwgeom/liblwgeom.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "postgis/geography_measurement_trees.hpp"
 
 namespace duckdb {
 
@@ -33,10 +34,18 @@ namespace duckdb {
 #define _LIBGEOGRAPHY_MEASUREMENT_H 1
 
 double geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
+double geography_distance_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, bool use_spheroid);
+void geography_distance_points(const double *lon1, const double *lat1, const double *lon2, const double *lat2,
+                               size_t count, int32_t srid, bool use_spheroid, double *distances);
+bool geography_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance, bool use_spheroid);
+bool geography_dwithin_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, double tolerance, bool use_spheroid);
+bool geography_dwithin_box_reject(const GBOX *box1, bool edges1, const GBOX *box2, bool edges2, int32_t srid,
+                                  double tolerance, bool use_spheroid);
 double geography_maxdistance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool use_spheroid);
 double geography_area(GSERIALIZED *g, bool use_spheroid);
 double geography_perimeter(GSERIALIZED *g, bool use_spheroid);
 double geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2);
+double geography_azimuth(const POINT2D *p1, const POINT2D *p2, int32_t srid);
 double geography_length(GSERIALIZED *g, bool use_spheroid);
 
 #endif /* !defined _LIBGEOGRAPHY_MEASUREMENT_H  */
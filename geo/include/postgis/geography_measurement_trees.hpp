@@ -26,6 +26,7 @@
 #include "duckdb.hpp"
 #include "liblwgeom/liblwgeom.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
+#include "liblwgeom/lwgeodetic_tree.hpp"
 
 namespace duckdb {
 
@@ -38,6 +39,24 @@ int geography_tree_distance(const GSERIALIZED *g1, const GSERIALIZED *g2, const
 int geography_tree_maxdistance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
                                double *distance);
 
+/*
+ * The circular tree of a geography that repeats across calls (e.g. a constant
+ * argument), kept alive so only the other argument needs a tree per call.
+ */
+typedef struct {
+	GSERIALIZED *gser;
+	LWGEOM *lwgeom;
+	CIRC_NODE *index;
+	POINT4D startpoint;
+} CircTreeGeomCache;
+
+/* Takes ownership of gser */
+CircTreeGeomCache *GetCircTreeGeomCache(GSERIALIZED *gser);
+void CircTreeGeomCacheFree(CircTreeGeomCache *cache);
+
+int geography_tree_distance_cached(const CircTreeGeomCache *cache, const GSERIALIZED *g, const SPHEROID *s,
+                                   double tolerance, double *distance);
+
 #endif /* !defined _LIBGEOGRAPHY_MEASUREMENT_TREES_H  */
 
 } // namespace duckdb
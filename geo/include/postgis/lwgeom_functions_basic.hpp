@@ -38,6 +38,7 @@ double ST_distance(GSERIALIZED *geom1, GSERIALIZED *geom2);
 lwvarlena_t *ST_GeoHash(GSERIALIZED *gser, size_t m_chars = 0);
 bool ST_IsCollection(GSERIALIZED *geom);
 bool LWGEOM_isempty(GSERIALIZED *geom);
+bool LWGEOM_isempty(LWGEOM *lwgeom);
 int LWGEOM_npoints(GSERIALIZED *geom);
 GSERIALIZED *LWGEOM_closestpoint(GSERIALIZED *geom1, GSERIALIZED *geom2);
 bool LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance);
@@ -48,6 +49,8 @@ double LWGEOM_perimeter2d_poly(GSERIALIZED *geom);
 double LWGEOM_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2);
 double LWGEOM_length2d_linestring(GSERIALIZED *geom);
 GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom);
+GSERIALIZED *LWGEOM_envelope_box(const GBOX *box, int32_t srid);
+bool LWGEOM_calculate_gbox(GSERIALIZED *geom, GBOX *box);
 double LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2);
 GSERIALIZED *LWGEOM_envelope_garray(GSERIALIZED *gserArray[], int nelems);
 
@@ -0,0 +1,57 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright 2008 Paul Ramsey <pramsey@cleverelephant.ca>
+ * Copyright 2007 Refractions Research Inc.
+ *
+ **********************************************************************/
+
+#pragma once
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+/*
+ * The binary predicates that can be evaluated against a prepared geometry.
+ * The prepared geometry is always the first argument of the predicate.
+ */
+enum class PreparedPredicate : uint8_t { CONTAINS, WITHIN, COVERS, COVEREDBY, INTERSECTS, DISJOINT };
+
+/*
+ * A constant predicate argument deserialized, converted to GEOS and prepared once,
+ * so that it can be tested against many geometries.
+ */
+struct PrepGeomCache;
+
+/* Takes ownership of gser */
+PrepGeomCache *GetPrepGeomCache(GSERIALIZED *gser);
+void PrepGeomCacheFree(PrepGeomCache *cache);
+
+bool prepared_predicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate);
+
+/*
+ * Evaluate the predicate against the 2D point (x, y) without building a geometry for it.
+ * Returns false when the point can not be handled this way (SRID mismatch, empty prepared
+ * geometry, predicate without a point shortcut); the caller then uses prepared_predicate.
+ */
+bool prepared_predicate_point(PrepGeomCache *cache, double x, double y, int32_t srid, PreparedPredicate predicate,
+                              bool *result);
+
+} // namespace duckdb
@@ -39,14 +39,18 @@ namespace duckdb {
  */
 GSERIALIZED *LWGEOM_in(char *input);
 GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size);
+//! Parse (E)WKB straight into an LWGEOM, without going through a GSERIALIZED
+LWGEOM *LWGEOM_getLwgeom(const void *base, size_t size);
 
 GSERIALIZED *geom_from_geojson(char *json);
 size_t LWGEOM_size(GSERIALIZED *gser);
 char *LWGEOM_base(GSERIALIZED *gser);
+string_t LWGEOM_base(GSERIALIZED *gser, Vector &result);
 lwvarlena_t *LWGEOM_asBinary(GSERIALIZED *gser, string text = "");
 std::string LWGEOM_asBinary(const void *base, size_t size);
 std::string LWGEOM_asText(GSERIALIZED *gser, size_t max_digits = OUT_DEFAULT_DECIMAL_DIGITS);
 std::string LWGEOM_asGeoJson(const void *base, size_t size);
 void LWGEOM_free(GSERIALIZED *gser);
+void LWGEOM_free(LWGEOM *lwgeom);
 
 } // namespace duckdb
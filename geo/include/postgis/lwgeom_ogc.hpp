@@ -34,6 +34,7 @@ GSERIALIZED *LWGEOM_boundary(GSERIALIZED *geom);
 int LWGEOM_dimension(GSERIALIZED *geom);
 GSERIALIZED *LWGEOM_endpoint_linestring(GSERIALIZED *geom);
 std::string geometry_geometrytype(GSERIALIZED *geom);
+const std::string &geometry_geometrytype(uint8_t type);
 bool LWGEOM_isclosed(GSERIALIZED *geom);
 int LWGEOM_numgeometries_collection(GSERIALIZED *geom);
 int LWGEOM_numpoints_linestring(GSERIALIZED *geom);
@@ -29,6 +29,13 @@
 
 namespace duckdb {
 
+class DBSCANTaskRunner;
+
 std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems, double tolerance, int minpoints);
+//! Same as above over geometries that are already deserialized; they are neither modified nor freed. Large inputs are
+//! clustered on the threads of runner, if any. The cluster ids are numbered in order of first appearance, so they do
+//! not depend on whether the clustering ran in parallel.
+std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+                                  DBSCANTaskRunner *runner = nullptr);
 
 } // namespace duckdb
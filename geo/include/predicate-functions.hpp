@@ -12,49 +12,66 @@
 
 namespace duckdb {
 
-static const std::vector<ScalarFunctionSet> GetPredicateScalarFunctions(LogicalType geo_type) {
+static const std::vector<ScalarFunctionSet> GetPredicateScalarFunctions(LogicalType geo_type, LogicalType point_type) {
 	std::vector<ScalarFunctionSet> func_set {};
 
 	// ST_CONTAINS
 	ScalarFunctionSet contains("st_contains");
 	contains.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryContainsFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryContainsFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
 	func_set.push_back(contains);
 
 	// ST_COVEREDBY
 	ScalarFunctionSet coveredby("st_coveredby");
 	coveredby.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoveredByFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoveredByFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
 	func_set.push_back(coveredby);
 
 	// ST_COVERS
 	ScalarFunctionSet covers("st_covers");
 	covers.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoversFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryCoversFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
 	func_set.push_back(covers);
 
 	// ST_DISJOINT
 	ScalarFunctionSet disjoint("st_disjoint");
 	disjoint.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryDisjointFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryDisjointFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
 	func_set.push_back(disjoint);
 
 	// ST_DWITHIN
 	ScalarFunctionSet dwithin("st_dwithin");
 	dwithin.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::DOUBLE}, LogicalType::BOOLEAN,
 	                                   GeoFunctions::GeometryDWithinFunction));
+	dwithin.AddFunction(ScalarFunction({geo_type, geo_type, LogicalType::DOUBLE, LogicalType::BOOLEAN},
+	                                   LogicalType::BOOLEAN, GeoFunctions::GeometryDWithinFunction, nullptr, nullptr,
+	                                   nullptr, GeoFunctions::InitCircTreeLocalState));
+	dwithin.AddFunction(ScalarFunction({point_type, point_type, LogicalType::DOUBLE}, LogicalType::BOOLEAN,
+	                                   GeoFunctions::PointDWithinFunction));
+	dwithin.AddFunction(ScalarFunction({point_type, point_type, LogicalType::DOUBLE, LogicalType::BOOLEAN},
+	                                   LogicalType::BOOLEAN, GeoFunctions::PointDWithinFunction));
 	func_set.push_back(dwithin);
 
 	// ST_EQUALS
 	ScalarFunctionSet equals("st_equals");
 	equals.AddFunction(
 	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryEqualsFunction));
+	equals.AddFunction(
+	    ScalarFunction({point_type, point_type}, LogicalType::BOOLEAN, GeoFunctions::PointEqualsFunction));
 	func_set.push_back(equals);
 
 	// ST_INTERSECTS
 	ScalarFunctionSet intersects("st_intersects");
 	intersects.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryIntersectsFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryIntersectsFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
+	// two points intersect exactly when they are equal
+	intersects.AddFunction(
+	    ScalarFunction({point_type, point_type}, LogicalType::BOOLEAN, GeoFunctions::PointEqualsFunction));
 	func_set.push_back(intersects);
 
 	// ST_TOUCHES
@@ -66,7 +83,8 @@ static const std::vector<ScalarFunctionSet> GetPredicateScalarFunctions(LogicalT
 	// ST_WITHIN
 	ScalarFunctionSet within("st_within");
 	within.AddFunction(
-	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryWithinFunction));
+	    ScalarFunction({geo_type, geo_type}, LogicalType::BOOLEAN, GeoFunctions::GeometryWithinFunction, nullptr,
+	                   nullptr, nullptr, GeoFunctions::InitPreparedPredicateLocalState));
 	func_set.push_back(within);
 
 	return func_set;
@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// space-filling-curve.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+
+namespace duckdb {
+
+//! The SpaceFillingCurve class computes the sort keys of ST_HILBERT and ST_ZORDER: the position of a point along a
+//! Hilbert or Z-order curve over a 2^32 x 2^32 grid. Sorting by these keys puts nearby points in nearby rows, so the
+//! min/max zonemaps of the row groups can skip the rows a spatial filter does not need.
+//! Coordinates are first mapped to grid cells, either scaled linearly to a known extent or, without one, through the
+//! ordered bits of their float value, which covers every double without any extent.
+class SpaceFillingCurve {
+public:
+	//! Grid cell of value scaled from [min, max], clamping values outside the range
+	static uint32_t Scale(double value, double min, double max);
+	//! Grid cell of value from the bits of the nearest float, ordered so that smaller values get smaller cells
+	static uint32_t OrderedBits(double value);
+
+	//! Compute the Z-order (Morton) index of count cells, the bits of x and y interleaved with x first
+	static void ZOrder(const uint32_t *x, const uint32_t *y, idx_t count, uint64_t *result);
+	//! Compute the Hilbert index of count cells, with a branch-free kernel that processes all the bits of a cell at
+	//! once instead of walking the curve one level at a time
+	static void Hilbert(const uint32_t *x, const uint32_t *y, idx_t count, uint64_t *result);
+};
+
+} // namespace duckdb
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// spatial-join.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/row_layout.hpp"
+#include "duckdb/execution/operator/join/physical_join.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+
+namespace duckdb {
+
+//! LogicalSpatialJoin is an inner join whose condition is a single ST_Intersects, ST_Contains, ST_Within or ST_DWithin
+//! call with one geometry argument computed from each side. It replaces the ANY join (a nested loop over the cross
+//! product) that DuckDB would otherwise plan for such a condition.
+class LogicalSpatialJoin : public LogicalExtensionOperator {
+public:
+	LogicalSpatialJoin(unique_ptr<Expression> predicate, idx_t left_arg, double distance);
+
+	//! The spatial predicate; its first two children are the geometry arguments
+	unique_ptr<Expression> predicate;
+	//! Which geometry argument of the predicate (0 or 1) is computed from the left child
+	idx_t left_arg;
+	//! The ST_DWithin distance by which probe envelopes are expanded (0 for the other predicates)
+	double distance;
+
+public:
+	vector<ColumnBinding> GetColumnBindings() override;
+	string ParamsToString() const override;
+	void Serialize(FieldWriter &writer) const override;
+	unique_ptr<PhysicalOperator> CreatePlan(ClientContext &context, PhysicalPlanGenerator &generator) override;
+
+protected:
+	void ResolveTypes() override;
+};
+
+//! PhysicalSpatialJoin materializes the build side in a row layout, as the hash join does, indexes the envelopes of its
+//! geometries in a packed STR-tree and probes the tree with the envelope of every probe row. Candidate pairs are then
+//! checked with the exact predicate. The probe side runs in parallel; the tree is read-only once the build side is
+//! finalized.
+class PhysicalSpatialJoin : public PhysicalJoin {
+public:
+	PhysicalSpatialJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> probe, unique_ptr<PhysicalOperator> build,
+	                    unique_ptr<Expression> probe_geom, unique_ptr<Expression> build_geom,
+	                    unique_ptr<Expression> predicate, bool probe_is_first_arg, bool build_is_left, double distance,
+	                    idx_t estimated_cardinality);
+
+	//! The probe geometry, bound against the columns of the probe side
+	unique_ptr<Expression> probe_geom;
+	//! The build geometry, bound against the columns of the build side
+	unique_ptr<Expression> build_geom;
+	//! The exact predicate, evaluated over a chunk holding its first and second geometry argument
+	unique_ptr<Expression> predicate;
+	//! Whether the probe geometry is the first argument of the predicate
+	bool probe_is_first_arg;
+	//! Whether the build side is the left side of the original join (the output keeps the original column order)
+	bool build_is_left;
+	double distance;
+	//! The layout of the materialized build rows: the build columns, then the build geometry
+	RowLayout layout;
+
+public:
+	string GetName() const override;
+	string ParamsToString() const override;
+
+	// Operator Interface
+	unique_ptr<OperatorState> GetOperatorState(ExecutionContext &context) const override;
+	OperatorResultType Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+	                           GlobalOperatorState &gstate, OperatorState &state) const override;
+
+	bool ParallelOperator() const override {
+		return true;
+	}
+
+	// Sink Interface
+	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
+	SinkResultType Sink(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate,
+	                    DataChunk &input) const override;
+	void Combine(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          GlobalSinkState &gstate) const override;
+
+	bool IsSink() const override {
+		return true;
+	}
+	bool ParallelSink() const override {
+		return true;
+	}
+};
+
+//! The SpatialJoinOptimizer rewrites inner ANY joins on spatial predicates into LogicalSpatialJoin operators
+struct SpatialJoinOptimizer {
+	static void Optimize(ClientContext &context, OptimizerExtensionInfo *info, unique_ptr<LogicalOperator> &plan);
+	static OptimizerExtension GetOptimizerExtension();
+};
+
+} // namespace duckdb
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkb-builder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+//! The WKBBuilder class holds a geometry read from text as a flat list of nodes in pre-order, with the coordinates of
+//! all vertices in one buffer, and writes it as EWKB. The text readers (WKTReader, GeoJSONReader) fill it in a single
+//! pass; its buffers are reused across rows, so reading a value does not allocate once they have grown.
+class WKBBuilder {
+public:
+	struct Node {
+		//! The liblwgeom type, or 0 for a polygon ring
+		uint8_t type;
+		bool has_z;
+		bool has_m;
+		//! Same semantics as lwgeom_is_empty
+		bool empty;
+		//! Number of points (point, linestring, ring), rings (polygon) or members (collections). A collection writes
+		//! its first count members, so a reader can drop them by lowering it.
+		uint32_t count;
+		//! Offset of the first coordinate in coords
+		idx_t coords;
+		//! Index of the node following the last descendant of this one
+		idx_t end;
+	};
+
+	vector<Node> nodes;
+	//! The ordinates of all vertices, as many per vertex as the dimensions of its node
+	vector<double> coords;
+	int32_t srid;
+
+	//! Drop the nodes and coordinates of the previous geometry
+	void Reset();
+	//! Append an empty 2D node that starts at the current end of coords, and return its index
+	idx_t AddNode(uint8_t type);
+	//! Force the dimensions of node and all its descendants, as wkt_parser_set_dims does
+	void SetDimensionality(idx_t node, bool has_z, bool has_m);
+
+	//! Size of the EWKB of the geometry rooted at the first node
+	idx_t GetWKBSize() const;
+	//! Write the EWKB into target, which must hold GetWKBSize bytes. The bytes are the ones lwgeom_to_wkb writes with
+	//! WKB_EXTENDED for the same geometry.
+	void WriteWKB(data_ptr_t target) const;
+
+	//! Clinger's fast path: compute mantissa * 10^exponent when both factors are exact doubles, so the result is
+	//! correctly rounded. Returns false otherwise, and the reader falls back to strtod.
+	static bool TryExactDouble(uint64_t mantissa, int exponent, double &result);
+
+private:
+	idx_t NodeSize(idx_t node, bool with_srid) const;
+	data_ptr_t WriteNode(idx_t node, bool with_srid, data_ptr_t target) const;
+};
+
+} // namespace duckdb
@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkb-reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+//! Max nesting of collections, matches LW_PARSER_MAX_DEPTH of the WKB parser
+#define WKB_VIEW_MAX_DEPTH 200
+
+//! The decoded header of one (E)WKB geometry
+struct WKBGeometryHeader {
+	uint8_t type;
+	bool swap_bytes;
+	bool has_z;
+	bool has_m;
+	bool has_srid;
+	int32_t srid;
+
+	idx_t PointSize() const {
+		return (2 + has_z + has_m) * WKB_DOUBLE_SIZE;
+	}
+};
+
+//! A bounds-checked cursor over (E)WKB bytes, shared by WKBView and WKBTextWriter. Reads return false instead of
+//! raising an error, so the callers can fall back to lwgeom_from_wkb and its errors.
+struct WKBReader {
+	const_data_ptr_t pos;
+	const_data_ptr_t end;
+	bool swap_bytes;
+
+	idx_t Remaining() const {
+		return end - pos;
+	}
+
+	bool ReadByte(uint8_t &value) {
+		if (Remaining() < WKB_BYTE_SIZE) {
+			return false;
+		}
+		value = *pos;
+		pos += WKB_BYTE_SIZE;
+		return true;
+	}
+
+	bool ReadInteger(uint32_t &value) {
+		if (Remaining() < WKB_INT_SIZE) {
+			return false;
+		}
+		value = LoadInteger(pos, swap_bytes);
+		pos += WKB_INT_SIZE;
+		return true;
+	}
+
+	//! Read the byte order flag, the type and the optional SRID of a geometry, as lwgeom_from_wkb_state does.
+	//! Returns false for malformed headers and unknown types.
+	bool ReadHeader(WKBGeometryHeader &header);
+
+	static uint32_t LoadInteger(const_data_ptr_t ptr, bool swap) {
+		uint32_t value;
+		memcpy(&value, ptr, WKB_INT_SIZE);
+		if (swap) {
+			value = ((value & 0x000000FF) << 24) | ((value & 0x0000FF00) << 8) | ((value & 0x00FF0000) >> 8) |
+			        ((value & 0xFF000000) >> 24);
+		}
+		return value;
+	}
+
+	static double LoadDouble(const_data_ptr_t ptr, bool swap) {
+		double value;
+		if (!swap) {
+			memcpy(&value, ptr, WKB_DOUBLE_SIZE);
+			return value;
+		}
+		uint8_t bytes[WKB_DOUBLE_SIZE];
+		for (idx_t i = 0; i < WKB_DOUBLE_SIZE; i++) {
+			bytes[i] = ptr[WKB_DOUBLE_SIZE - i - 1];
+		}
+		memcpy(&value, bytes, WKB_DOUBLE_SIZE);
+		return value;
+	}
+};
+
+} // namespace duckdb
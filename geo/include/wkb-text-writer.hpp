@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkb-text-writer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "wkb-reader.hpp"
+#include "wkb-view.hpp"
+
+namespace duckdb {
+
+//! The WKBTextWriter class formats GEOGRAPHY values as text straight from their EWKB, without building an LWGEOM, a
+//! GSERIALIZED or a per-row string. Digits are printed with lwprint_double into a scratch buffer that is reused across
+//! rows, so the caller copies each text once, into the result vector.
+//! The Try* methods return false for malformed values and for what they leave to liblwgeom (curves, triangles, TINs,
+//! polyhedral surfaces, and the GeoJSON of nested collections); the caller then falls back to the LWGEOM path, which
+//! produces the same text or raises the usual errors.
+class WKBTextWriter {
+public:
+	//! Format view as the text lwgeom_to_wkt writes with WKT_ISO and the given precision
+	bool TryWriteWKT(const WKBView &view, int precision);
+	//! Format view as the text lwgeom_to_geojson writes with the given precision, without crs and bbox members
+	bool TryWriteGeoJSON(const WKBView &view, int precision);
+	//! The text of the last value written, valid until the next call
+	const char *GetData() const {
+		return buffer.data();
+	}
+	idx_t GetSize() const {
+		return size;
+	}
+
+	//! Whether WriteHexWKB can format view: the bytes must be canonical (see WKBView::IsCanonical) and little-endian
+	static bool CanWriteHexWKB(const WKBView &view);
+	//! Write the hex of the EWKB of view into target, which must hold 2 * view.GetSize() characters. The text is the
+	//! one lwgeom_to_hexwkb_buffer writes with WKB_NDR | WKB_EXTENDED.
+	static void WriteHexWKB(const WKBView &view, char *target);
+
+private:
+	vector<char> buffer;
+	idx_t size;
+
+	bool WriteWKTGeometry(WKBReader &reader, uint8_t parent_type, int precision, idx_t depth);
+	bool WriteWKTPointArray(WKBReader &reader, const WKBGeometryHeader &header, uint32_t npoints, bool parens,
+	                        int precision);
+	void WriteWKTEmpty();
+
+	bool WriteGeoJSONGeometry(WKBReader &reader, bool member, int precision);
+	bool WriteGeoJSONPointArray(WKBReader &reader, const WKBGeometryHeader &header, uint32_t npoints, int precision);
+	bool WriteGeoJSONRings(WKBReader &reader, const WKBGeometryHeader &header, int precision);
+
+	//! Grow the buffer so that len more characters fit
+	void Reserve(idx_t len);
+	void Append(const char *str, idx_t len);
+	void Append(char c);
+	void AppendDouble(double d, int precision);
+};
+
+} // namespace duckdb
@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkb-validator.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "wkb-reader.hpp"
+
+namespace duckdb {
+
+//! The WKBValidator class reads WKB and EWKB blobs (ST_GEOMFROMWKB) into GEOGRAPHY values without building an LWGEOM.
+//! A first walk checks the structure as lwgeom_from_wkb does with LW_PARSER_CHECK_ALL and computes the size of the
+//! value; blobs that are already in the stored form are then copied as is, and the others (other byte order, ISO type
+//! numbers, nested SRIDs, trailing bytes, ...) are rewritten in a second walk.
+//! TryValidate returns false for malformed blobs and for what it leaves to liblwgeom (curves, triangles, TINs,
+//! polyhedral surfaces); the caller then falls back to LWGEOM_from_WKB, which reads the same value or raises the
+//! usual errors.
+class WKBValidator {
+public:
+	//! Validate the blob in data. A srid other than SRID_UNKNOWN replaces its SRID, as in LWGEOM_from_WKB.
+	bool TryValidate(const_data_ptr_t data, idx_t size, int32_t srid = SRID_UNKNOWN);
+	//! Whether the blob is already the EWKB lwgeom_to_wkb writes with WKB_EXTENDED, so it can be stored as is
+	bool IsCanonical() const {
+		return canonical;
+	}
+	//! Size of the GEOGRAPHY value
+	idx_t GetSize() const {
+		return result_size;
+	}
+	//! Write the GEOGRAPHY value into target, which must hold GetSize bytes
+	void Write(data_ptr_t target) const;
+
+private:
+	const_data_ptr_t data;
+	idx_t size;
+	int32_t srid;
+	bool canonical;
+	idx_t result_size;
+
+	bool ValidateGeometry(WKBReader &reader, const WKBGeometryHeader *parent, idx_t depth);
+	data_ptr_t WriteGeometry(WKBReader &reader, bool top_level, data_ptr_t target) const;
+};
+
+} // namespace duckdb
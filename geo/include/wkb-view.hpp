@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkb-view.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "liblwgeom/liblwgeom.hpp"
+
+namespace duckdb {
+
+//! A GEOGRAPHY value may carry its 2D bounding box in front of the EWKB (see ST_AddBBox). The prefix starts with a
+//! marker byte that can never start a WKB, whose first byte is the 0/1 byte order flag, so plain EWKB values are read
+//! unchanged. Layout: marker, version, 6 bytes of padding, then xmin, ymin, xmax, ymax as little-endian doubles.
+#define GEOGRAPHY_BBOX_MARKER 0x42
+#define GEOGRAPHY_BBOX_VERSION 1
+#define GEOGRAPHY_BBOX_PREFIX_SIZE 40
+
+//! Size of the EWKB of a POINT without SRID, in 2D and with Z (see WKBView::WritePoint)
+#define GEOGRAPHY_POINT_SIZE 21
+#define GEOGRAPHY_POINTZ_SIZE 29
+
+//! The WKBView class is a read-only, non-owning view over the (E)WKB bytes of a GEOGRAPHY value.
+//! Only the header is decoded on construction; the body is walked on demand, so accessors never allocate and never
+//! build an LWGEOM. The Try* methods return false when the geometry is malformed or uses a feature the view does not
+//! handle (e.g. curves for bounding boxes), in which case the caller falls back to the GSERIALIZED path.
+class WKBView {
+public:
+	WKBView(const_data_ptr_t data, idx_t size);
+	explicit WKBView(string_t blob);
+
+	//! Whether the header was decoded successfully
+	bool IsValid() const {
+		return type != 0;
+	}
+	//! The liblwgeom type (POINTTYPE, LINETYPE, ...) of the outermost geometry
+	uint8_t GetType() const {
+		return type;
+	}
+	bool HasZ() const {
+		return has_z;
+	}
+	bool HasM() const {
+		return has_m;
+	}
+	bool HasSRID() const {
+		return has_srid;
+	}
+	int32_t GetSRID() const {
+		return srid;
+	}
+	//! The EWKB bytes, without the cached bounding box prefix
+	const_data_ptr_t GetData() const {
+		return data;
+	}
+	idx_t GetSize() const {
+		return size;
+	}
+	//! Whether the value carries a cached bounding box prefix
+	bool HasCachedBBox() const {
+		return has_cached_bbox;
+	}
+
+	//! Whether the EWKB bytes are exactly the ones lwgeom_to_wkb writes with WKB_EXTENDED, in machine byte order, for
+	//! the geometry they encode. Such bytes survive a round trip through LWGEOM unchanged, so they can be used as is.
+	//! Only points, linestrings, polygons and their collections are checked; anything else is reported as false.
+	bool IsCanonical() const;
+	//! Whether the geometry has no vertices (same semantics as lwgeom_is_empty)
+	bool TryIsEmpty(bool &result) const;
+	//! Number of vertices (same semantics as lwgeom_count_vertices)
+	bool TryNumPoints(uint32_t &result) const;
+	//! Whether all linear components are closed (same semantics as lwgeom_is_closed)
+	bool TryIsClosed(bool &result) const;
+	//! Number of members (same semantics as ST_NumGeometries: 0 if empty, 1 for a non-collection)
+	bool TryNumGeometries(uint32_t &result) const;
+	//! Topological dimension (same semantics as lwgeom_dimension), read from the header unless it is a collection
+	bool TryDimension(int &result) const;
+	//! Read the coordinates of a non-empty POINT
+	bool TryGetPoint(POINT4D &result) const;
+	//! Read the first vertex of a non-empty LINESTRING or CIRCULARSTRING
+	bool TryGetStartPoint(POINT4D &result) const;
+	//! Compute the 2D cartesian bounding box, or return the cached one in O(1). An empty geometry yields an inverted
+	//! box (xmin > xmax).
+	bool TryGetBBox(GBOX &result) const;
+	//! Whether the geometry is a POLYGON without holes whose shell is an axis-aligned rectangle of non-zero area
+	bool TryIsRectangle(bool &result) const;
+
+	//! Whether both views hold exactly the same bytes
+	static bool BinaryEquals(const WKBView &lhs, const WKBView &rhs);
+
+	//! Write the bounding box prefix for box into target, which must hold GEOGRAPHY_BBOX_PREFIX_SIZE bytes
+	static void WriteBBoxPrefix(const GBOX &box, data_ptr_t target);
+	//! Size of the EWKB of a POINT with the given dimensions and SRID
+	static idx_t PointSize(bool has_z, bool has_m, int32_t srid);
+	//! Write the EWKB of a POINT into target, which must hold PointSize bytes. The bytes are the ones lwgeom_to_wkb
+	//! writes with WKB_EXTENDED, so the value equals the serialized LWPOINT.
+	static void WritePoint(const POINT4D &point, bool has_z, bool has_m, int32_t srid, data_ptr_t target);
+	//! Write the EWKB of a 2D POINT without SRID into target, which must hold GEOGRAPHY_POINT_SIZE bytes
+	static void WritePoint(double x, double y, data_ptr_t target);
+	//! Same as WritePoint for a point with Z, target must hold GEOGRAPHY_POINTZ_SIZE bytes
+	static void WritePoint(double x, double y, double z, data_ptr_t target);
+	//! Size of the EWKB of the geometry BOX2D_to_LWGEOM builds for box (see WriteEnvelope)
+	static idx_t EnvelopeSize(const GBOX &box);
+	//! Write the EWKB of the geometry BOX2D_to_LWGEOM builds for box into target, which must hold EnvelopeSize bytes:
+	//! a POINT if the box is a point, a LINESTRING if it is flat, and a clockwise rectangle POLYGON otherwise
+	static void WriteEnvelope(const GBOX &box, data_ptr_t target);
+
+private:
+	const_data_ptr_t data;
+	idx_t size;
+	//! Offset of the first byte following the header
+	idx_t body;
+	uint8_t type;
+	bool swap_bytes;
+	bool has_z;
+	bool has_m;
+	bool has_srid;
+	int32_t srid;
+	bool has_cached_bbox;
+	GBOX cached_bbox;
+};
+
+} // namespace duckdb
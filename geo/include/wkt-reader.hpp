@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// wkt-reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types.hpp"
+#include "wkb-builder.hpp"
+
+namespace duckdb {
+
+//! The WKTReader class is a hand-written, reentrant reader for the WKT accepted by lwgeom_parse_wkt with
+//! LW_PARSER_CHECK_ALL. It reads the text into a WKBBuilder and writes the EWKB straight into the caller's buffer,
+//! without building an LWGEOM or a GSERIALIZED. It holds no global state, so one reader per thread (or per cast) can be
+//! reused across rows.
+//! TryRead returns false for anything it does not handle: invalid WKT, checks that fail, curves, triangles,
+//! polyhedral surfaces, and collections mixing dimensions. The caller then falls back to the liblwgeom parser, which
+//! raises the usual errors, so the accepted input and the resulting bytes are exactly the ones of the bison parser.
+class WKTReader {
+public:
+	//! Read text as WKT, with an optional SRID=<srid>; prefix
+	bool TryRead(const char *text, idx_t len);
+	//! Size of the EWKB of the last geometry read
+	idx_t GetWKBSize() const {
+		return builder.GetWKBSize();
+	}
+	//! Write the EWKB of the last geometry read into target, which must hold GetWKBSize bytes. The bytes are the ones
+	//! lwgeom_to_wkb writes with WKB_EXTENDED.
+	void WriteWKB(data_ptr_t target) const {
+		builder.WriteWKB(target);
+	}
+
+private:
+	const char *pos;
+	const char *end;
+	WKBBuilder builder;
+
+	bool ReadGeometry(idx_t depth);
+	bool ReadPointText(idx_t node, bool tagged, bool member);
+	bool ReadLineStringText(idx_t node, bool tagged);
+	bool ReadPolygonText(idx_t node, bool tagged);
+	bool ReadCollectionText(idx_t node, uint8_t type, bool tagged, idx_t depth);
+	bool ReadPointArray(idx_t node, int &ndims);
+	bool ReadCoordinate(int &ndims);
+	bool ReadDimensionality(bool &has_z, bool &has_m);
+	bool ApplyDimensionality(idx_t node, int ndims, bool tagged);
+
+	void SkipWhitespace();
+	bool Consume(char c);
+	bool ConsumeKeyword(const char *keyword, idx_t len);
+	bool ReadDouble(double &result);
+};
+
+} // namespace duckdb
@@ -1762,21 +1762,27 @@ double lwgeom_length_spheroid(const LWGEOM *geom, const SPHEROID *s) {
  *
  */
 double lwgeom_azumith_spheroid(const LWPOINT *r, const LWPOINT *s, const SPHEROID *spheroid) {
-	GEOGRAPHIC_POINT g1, g2;
-	double x1, y1, x2, y2, az;
+	POINT2D p1, p2;
+	p1.x = lwpoint_get_x(r);
+	p1.y = lwpoint_get_y(r);
+	p2.x = lwpoint_get_x(s);
+	p2.y = lwpoint_get_y(s);
+	return lw_azimuth_spheroid_2d(&p1, &p2, spheroid);
+}
 
-	/* Convert r to a geodetic point */
-	x1 = lwpoint_get_x(r);
-	y1 = lwpoint_get_y(r);
-	geographic_point_init(x1, y1, &g1);
+/**
+ * Same as #lwgeom_azumith_spheroid, for bare coordinates.
+ */
+double lw_azimuth_spheroid_2d(const POINT2D *r, const POINT2D *s, const SPHEROID *spheroid) {
+	GEOGRAPHIC_POINT g1, g2;
+	double az;
 
-	/* Convert s to a geodetic point */
-	x2 = lwpoint_get_x(s);
-	y2 = lwpoint_get_y(s);
-	geographic_point_init(x2, y2, &g2);
+	/* Convert r and s to geodetic points */
+	geographic_point_init(r->x, r->y, &g1);
+	geographic_point_init(s->x, s->y, &g2);
 
 	/* Same point, return NaN */
-	if (FP_EQUALS(x1, x2) && FP_EQUALS(y1, y2)) {
+	if (FP_EQUALS(r->x, s->x) && FP_EQUALS(r->y, s->y)) {
 		return NAN;
 	}
 
@@ -28,12 +28,26 @@
 #include "liblwgeom/lwinline.hpp"
 #include "liblwgeom/lwunionfind.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <geos/geom/Coordinate.hpp>
+#include <geos/geom/Envelope.hpp>
+#include <geos/index/kdtree/KdTree.hpp>
 #include <string.h>
+#include <vector>
 
 namespace duckdb {
 
 static const int STRTREE_NODE_CAPACITY = 10;
 
+/* Inputs below this count are clustered on the calling thread */
+static const uint32_t DBSCAN_PARALLEL_MIN_GEOMS = 4096;
+/* Number of inputs a worker thread takes at a time */
+static const uint32_t DBSCAN_PARALLEL_BATCH_SIZE = 512;
+static const uint32_t PACKED_TREE_NODE_CAPACITY = 16;
+
 /* Utility struct used to accumulate items in GEOSSTRtree_query callback */
 struct QueryContext {
 	void **items_found;
@@ -49,6 +63,17 @@ struct STRTree {
 	uint32_t num_geoms;
 };
 
+/* Neighbour index of the DBSCAN inputs. When every input is a non-empty point, the points
+ * go in a KdTree instead of an STRtree, which spares building one GEOS envelope per input. */
+struct DBSCANIndex {
+	struct STRTree strtree;
+	geos::index::kdtree::KdTree *kdtree;
+	/* Ids of the inputs at each distinct point, the KdTree keeps coincident points in one node */
+	std::vector<std::vector<uint32_t>> *point_ids;
+	/* Nodes found by the last KdTree query */
+	std::vector<geos::index::kdtree::KdNode *> *nodes;
+};
+
 static struct STRTree make_strtree(void **geoms, uint32_t num_geoms, char is_lwgeom);
 static void destroy_strtree(struct STRTree *tree);
 
@@ -135,9 +160,85 @@ static void query_accumulate(void *item, void *userdata) {
 	cxt->items_found[cxt->num_items_found++] = item;
 }
 
-static int dbscan_update_context(GEOSSTRtree *tree, struct QueryContext *cxt, LWGEOM **geoms, uint32_t p, double eps) {
+static int make_dbscan_index(struct DBSCANIndex *index, LWGEOM **geoms, uint32_t num_geoms) {
+	uint32_t i;
+	uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+	index->strtree.tree = NULL;
+	index->kdtree = NULL;
+	index->point_ids = NULL;
+	index->nodes = NULL;
+
+	for (i = 0; i < num_geoms; i++) {
+		if (geoms[i]->type != POINTTYPE || lwgeom_is_empty(geoms[i]))
+			break;
+	}
+	if (i < num_geoms) {
+		index->strtree = make_strtree((void **)geoms, num_geoms, LW_TRUE);
+		return index->strtree.tree ? LW_SUCCESS : LW_FAILURE;
+	}
+
+	/* The KdTree is never rebalanced: insert the points in a fixed pseudo-random order, so that
+	 * sorted input, as an ordered window hands it over, does not degenerate it into a list. */
+	std::vector<uint32_t> order(num_geoms);
+	for (i = 0; i < num_geoms; i++)
+		order[i] = i;
+	for (i = num_geoms - 1; i > 0; i--) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		std::swap(order[i], order[(seed >> 33) % (i + 1)]);
+	}
+
+	index->kdtree = new geos::index::kdtree::KdTree();
+	index->point_ids = new std::vector<std::vector<uint32_t>>();
+	index->nodes = new std::vector<geos::index::kdtree::KdNode *>();
+	for (i = 0; i < num_geoms; i++) {
+		uint32_t id = order[i];
+		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[id])->point, 0);
+		void *group = (void *)(uintptr_t)(index->point_ids->size() + 1);
+		geos::index::kdtree::KdNode *node = index->kdtree->insert(geos::geom::Coordinate(pt->x, pt->y), group);
+
+		if (node->getData() == group)
+			index->point_ids->push_back(std::vector<uint32_t>(1, id));
+		else
+			(*index->point_ids)[(uintptr_t)node->getData() - 1].push_back(id);
+	}
+
+	return LW_SUCCESS;
+}
+
+static void destroy_dbscan_index(struct DBSCANIndex *index) {
+	if (index->kdtree) {
+		delete index->kdtree;
+		delete index->point_ids;
+		delete index->nodes;
+	} else if (index->strtree.tree) {
+		destroy_strtree(&index->strtree);
+	}
+}
+
+static bool compare_item_ids(void *a, void *b) {
+	return *((uint32_t *)a) < *((uint32_t *)b);
+}
+
+static int dbscan_update_context(struct DBSCANIndex *index, struct QueryContext *cxt, LWGEOM **geoms, uint32_t p,
+                                 double eps) {
 	cxt->num_items_found = 0;
 
+	if (index->kdtree) {
+		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[p])->point, 0);
+		index->nodes->clear();
+		index->kdtree->query(geos::geom::Envelope(pt->x - eps, pt->x + eps, pt->y - eps, pt->y + eps),
+		                     *index->nodes);
+		for (auto node : *index->nodes) {
+			for (auto &id : (*index->point_ids)[(uintptr_t)node->getData() - 1]) {
+				query_accumulate(&id, cxt);
+			}
+		}
+		/* Visit the neighbours in input order, whatever the shape of the tree */
+		std::sort(cxt->items_found, cxt->items_found + cxt->num_items_found, compare_item_ids);
+		return LW_SUCCESS;
+	}
+
 	GEOSGeometry *query_envelope;
 	if (geoms[p]->type == POINTTYPE) {
 		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[p])->point, 0);
@@ -150,7 +251,7 @@ static int dbscan_update_context(GEOSSTRtree *tree, struct QueryContext *cxt, LW
 	if (!query_envelope)
 		return LW_FAILURE;
 
-	GEOSSTRtree_query(tree, query_envelope, &query_accumulate, cxt);
+	GEOSSTRtree_query(index->strtree.tree, query_envelope, &query_accumulate, cxt);
 
 	GEOSGeom_destroy(query_envelope);
 
@@ -183,7 +284,7 @@ static void union_if_available(UNIONFIND *uf, uint32_t p, uint32_t q, char *is_i
 static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps,
                                     char **in_a_cluster_ret) {
 	uint32_t p, i;
-	struct STRTree tree;
+	struct DBSCANIndex index;
 	struct QueryContext cxt = {.items_found = NULL, .num_items_found = 0, .items_found_size = 0};
 	int success = LW_SUCCESS;
 
@@ -197,9 +298,8 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 	if (num_geoms <= 1)
 		return LW_SUCCESS;
 
-	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE);
-	if (tree.tree == NULL) {
-		destroy_strtree(&tree);
+	if (make_dbscan_index(&index, geoms, num_geoms) == LW_FAILURE) {
+		destroy_dbscan_index(&index);
 		return LW_FAILURE;
 	}
 
@@ -207,7 +307,7 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		dbscan_update_context(&index, &cxt, geoms, p, eps);
 		for (i = 0; i < cxt.num_items_found; i++) {
 			uint32_t q = *((uint32_t *)cxt.items_found[i]);
 
@@ -227,7 +327,7 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 	if (cxt.items_found)
 		lwfree(cxt.items_found);
 
-	destroy_strtree(&tree);
+	destroy_dbscan_index(&index);
 
 	return success;
 }
@@ -235,7 +335,7 @@ static int union_dbscan_minpoints_1(LWGEOM **geoms, uint32_t num_geoms, UNIONFIN
 static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
                                 char **in_a_cluster_ret) {
 	uint32_t p, i;
-	struct STRTree tree;
+	struct DBSCANIndex index;
 	struct QueryContext cxt = {.items_found = NULL, .num_items_found = 0, .items_found_size = 0};
 	int success = LW_SUCCESS;
 	uint32_t *neighbors;
@@ -255,9 +355,10 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 		return LW_SUCCESS;
 	}
 
-	tree = make_strtree((void **)geoms, num_geoms, LW_TRUE);
-	if (tree.tree == NULL) {
-		destroy_strtree(&tree);
+	if (make_dbscan_index(&index, geoms, num_geoms) == LW_FAILURE) {
+		destroy_dbscan_index(&index);
+		if (!in_a_cluster_ret)
+			lwfree(in_a_cluster);
 		return LW_FAILURE;
 	}
 
@@ -271,7 +372,7 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		dbscan_update_context(&index, &cxt, geoms, p, eps);
 
 		/* We didn't find enough points to do anything, even if they are all within eps. */
 		if (cxt.num_items_found < min_points)
@@ -343,12 +444,298 @@ static int union_dbscan_general(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *u
 	if (cxt.items_found)
 		lwfree(cxt.items_found);
 
-	destroy_strtree(&tree);
+	destroy_dbscan_index(&index);
 	return success;
 }
 
+/* 2D box of a packed tree entry */
+struct PackedBox {
+	double xmin, ymin, xmax, ymax;
+};
+
+/* Bulk-loaded Sort-Tile-Recursive R-tree over the boxes of the inputs. It is never
+ * modified once built, so any number of threads can query it at the same time. */
+struct PackedTree {
+	/* Input id of each leaf entry */
+	std::vector<uint32_t> ids;
+	/* Boxes of each level, level 0 holding the leaf entries in the order of ids. Entry i
+	 * of level k + 1 covers entries [i * capacity, (i + 1) * capacity) of level k. */
+	std::vector<std::vector<PackedBox>> levels;
+};
+
+/* Query buffers of one worker thread */
+struct DBSCANWorker {
+	std::vector<uint32_t> found;
+	std::vector<std::pair<uint32_t, uint32_t>> stack;
+};
+
+static inline bool packed_box_intersects(const PackedBox &a, const PackedBox &b) {
+	return a.xmin <= b.xmax && b.xmin <= a.xmax && a.ymin <= b.ymax && b.ymin <= a.ymax;
+}
+
+static PackedBox dbscan_box(const LWGEOM *geom, double eps) {
+	PackedBox box;
+	if (geom->type == POINTTYPE) {
+		const POINT2D *pt = getPoint2d_cp(lwgeom_as_lwpoint(geom)->point, 0);
+		box.xmin = box.xmax = pt->x;
+		box.ymin = box.ymax = pt->y;
+	} else {
+		const GBOX *gbox = lwgeom_get_bbox(geom);
+		box.xmin = gbox->xmin;
+		box.ymin = gbox->ymin;
+		box.xmax = gbox->xmax;
+		box.ymax = gbox->ymax;
+	}
+	box.xmin -= eps;
+	box.ymin -= eps;
+	box.xmax += eps;
+	box.ymax += eps;
+	return box;
+}
+
+static void packed_tree_build(struct PackedTree *tree, LWGEOM **geoms, uint32_t num_geoms) {
+	uint32_t i, start, num_leaves, slice_size;
+	std::vector<PackedBox> boxes(num_geoms);
+
+	for (i = 0; i < num_geoms; i++) {
+		if (lwgeom_is_empty(geoms[i]))
+			continue;
+		boxes[i] = dbscan_box(geoms[i], 0.0);
+		tree->ids.push_back(i);
+	}
+	if (tree->ids.empty())
+		return;
+
+	/* Sort by x centre, cut into vertical slices of whole nodes, sort each slice by y centre */
+	auto &ids = tree->ids;
+	num_leaves = (ids.size() + PACKED_TREE_NODE_CAPACITY - 1) / PACKED_TREE_NODE_CAPACITY;
+	slice_size = (uint32_t)ceil(sqrt((double)num_leaves)) * PACKED_TREE_NODE_CAPACITY;
+	std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+		return boxes[a].xmin + boxes[a].xmax < boxes[b].xmin + boxes[b].xmax;
+	});
+	for (start = 0; start < ids.size(); start += slice_size) {
+		auto end = ids.begin() + std::min<size_t>(start + slice_size, ids.size());
+		std::sort(ids.begin() + start, end, [&](uint32_t a, uint32_t b) {
+			return boxes[a].ymin + boxes[a].ymax < boxes[b].ymin + boxes[b].ymax;
+		});
+	}
+
+	tree->levels.emplace_back();
+	for (auto id : ids)
+		tree->levels.back().push_back(boxes[id]);
+
+	/* Each node covers the next PACKED_TREE_NODE_CAPACITY entries of the level below */
+	while (tree->levels.back().size() > PACKED_TREE_NODE_CAPACITY) {
+		std::vector<PackedBox> parents;
+		const auto &children = tree->levels.back();
+		for (start = 0; start < children.size(); start += PACKED_TREE_NODE_CAPACITY) {
+			PackedBox box = children[start];
+			for (i = start + 1; i < std::min<size_t>(start + PACKED_TREE_NODE_CAPACITY, children.size()); i++) {
+				box.xmin = FP_MIN(box.xmin, children[i].xmin);
+				box.ymin = FP_MIN(box.ymin, children[i].ymin);
+				box.xmax = FP_MAX(box.xmax, children[i].xmax);
+				box.ymax = FP_MAX(box.ymax, children[i].ymax);
+			}
+			parents.push_back(box);
+		}
+		tree->levels.push_back(std::move(parents));
+	}
+}
+
+/* Ids of the inputs whose box is within eps of the box of geoms[p], in increasing order */
+static void packed_tree_query(const struct PackedTree *tree, LWGEOM **geoms, uint32_t p, double eps,
+                              struct DBSCANWorker *worker) {
+	uint32_t i;
+	PackedBox box = dbscan_box(geoms[p], eps);
+
+	worker->found.clear();
+	worker->stack.clear();
+	if (tree->levels.empty())
+		return;
+
+	uint32_t top = tree->levels.size() - 1;
+	for (i = 0; i < tree->levels[top].size(); i++) {
+		if (packed_box_intersects(tree->levels[top][i], box))
+			worker->stack.emplace_back(top, i);
+	}
+	while (!worker->stack.empty()) {
+		auto entry = worker->stack.back();
+		worker->stack.pop_back();
+		if (entry.first == 0) {
+			worker->found.push_back(tree->ids[entry.second]);
+			continue;
+		}
+		const auto &children = tree->levels[entry.first - 1];
+		uint32_t end = std::min<size_t>((entry.second + 1) * PACKED_TREE_NODE_CAPACITY, children.size());
+		for (i = entry.second * PACKED_TREE_NODE_CAPACITY; i < end; i++) {
+			if (packed_box_intersects(children[i], box))
+				worker->stack.emplace_back(entry.first - 1, i);
+		}
+	}
+	std::sort(worker->found.begin(), worker->found.end());
+}
+
+/* Compute the boxes of a geometry and of all its parts. The distance calculation adds
+ * missing boxes on the fly, which must not happen from several threads at once. */
+static void dbscan_add_bbox_deep(LWGEOM *geom) {
+	uint32_t i;
+	lwgeom_add_bbox(geom);
+	if (lwgeom_is_collection(geom)) {
+		LWCOLLECTION *col = lwgeom_as_lwcollection(geom);
+		for (i = 0; i < col->ngeoms; i++)
+			dbscan_add_bbox_deep(col->geoms[i]);
+	}
+}
+
+/* Call fun(p, worker) for every input from up to num_threads threads of the runner, which
+ * take batches of inputs in turn. The first exception thrown is raised again once every
+ * thread is done. */
+template <class FUNC>
+static void dbscan_parallel_for(uint32_t num_geoms, DBSCANTaskRunner *runner, uint32_t num_threads, FUNC fun) {
+	std::atomic<uint32_t> next(0);
+	std::exception_ptr error;
+	std::atomic<bool> has_error(false);
+
+	auto work = [&]() {
+		struct DBSCANWorker worker;
+		try {
+			while (!has_error.load(std::memory_order_relaxed)) {
+				uint32_t start = next.fetch_add(DBSCAN_PARALLEL_BATCH_SIZE);
+				if (start >= num_geoms)
+					break;
+				uint32_t end = std::min(start + DBSCAN_PARALLEL_BATCH_SIZE, num_geoms);
+				for (uint32_t p = start; p < end; p++)
+					fun(p, worker);
+			}
+		} catch (...) {
+			bool expected = false;
+			if (has_error.compare_exchange_strong(expected, true))
+				error = std::current_exception();
+		}
+	};
+
+	runner->Run(num_threads, work);
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+/* DBSCAN spread over worker threads, for large inputs. Core points are found first, then
+ * core points within eps of each other are merged in a concurrent union-find, and last
+ * every other point within eps of a core point joins the cluster of the first such core
+ * point in input order, which is also where the serial versions put it. */
+static int union_dbscan_parallel(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
+                                 char **in_a_cluster_ret, DBSCANTaskRunner *runner, uint32_t num_threads) {
+	uint32_t i;
+	struct PackedTree tree;
+	std::vector<char> is_in_core(num_geoms, min_points <= 1);
+	std::vector<uint32_t> border_of(num_geoms, UINT32_MAX);
+	std::atomic<bool> failed(false);
+	UNIONFIND_CONCURRENT *cuf;
+	char *in_a_cluster;
+
+	for (i = 0; i < num_geoms; i++)
+		dbscan_add_bbox_deep(geoms[i]);
+	packed_tree_build(&tree, geoms, num_geoms);
+
+	/* Core points have at least min_points inputs, themselves included, within eps */
+	if (min_points > 1) {
+		dbscan_parallel_for(num_geoms, runner, num_threads, [&](uint32_t p, DBSCANWorker &worker) {
+			uint32_t num_neighbors = 0;
+			if (lwgeom_is_empty(geoms[p]))
+				return;
+			packed_tree_query(&tree, geoms, p, eps, &worker);
+			if (worker.found.size() < min_points)
+				return;
+			for (auto q : worker.found) {
+				double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+				if (mindist == FLT_MAX) {
+					failed = true;
+					return;
+				}
+				if (mindist <= eps && ++num_neighbors >= min_points) {
+					is_in_core[p] = LW_TRUE;
+					return;
+				}
+			}
+		});
+	}
+
+	/* Clusters are the core points connected within eps, each pair is looked at from its smaller id */
+	cuf = UF_concurrent_create(num_geoms);
+	try {
+		dbscan_parallel_for(num_geoms, runner, num_threads, [&](uint32_t p, DBSCANWorker &worker) {
+			if (!is_in_core[p] || lwgeom_is_empty(geoms[p]))
+				return;
+			packed_tree_query(&tree, geoms, p, eps, &worker);
+			for (auto q : worker.found) {
+				if (q <= p || !is_in_core[q])
+					continue;
+				if (UF_concurrent_find(cuf, p) == UF_concurrent_find(cuf, q))
+					continue;
+				double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+				if (mindist == FLT_MAX) {
+					failed = true;
+					return;
+				}
+				if (mindist <= eps)
+					UF_concurrent_union(cuf, p, q);
+			}
+		});
+	} catch (...) {
+		UF_concurrent_destroy(cuf);
+		throw;
+	}
+	UF_concurrent_collect(cuf, uf);
+	UF_concurrent_destroy(cuf);
+
+	/* Border points join the cluster of their first core neighbour */
+	if (min_points > 1) {
+		dbscan_parallel_for(num_geoms, runner, num_threads, [&](uint32_t p, DBSCANWorker &worker) {
+			if (is_in_core[p] || lwgeom_is_empty(geoms[p]))
+				return;
+			packed_tree_query(&tree, geoms, p, eps, &worker);
+			for (auto q : worker.found) {
+				if (!is_in_core[q])
+					continue;
+				double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+				if (mindist == FLT_MAX) {
+					failed = true;
+					return;
+				}
+				if (mindist <= eps) {
+					border_of[p] = q;
+					return;
+				}
+			}
+		});
+	}
+
+	in_a_cluster = (char *)lwalloc(num_geoms * sizeof(char));
+	for (i = 0; i < num_geoms; i++) {
+		in_a_cluster[i] = is_in_core[i];
+		if (border_of[i] != UINT32_MAX) {
+			UF_union(uf, border_of[i], i);
+			in_a_cluster[i] = LW_TRUE;
+		}
+	}
+
+	if (in_a_cluster_ret)
+		*in_a_cluster_ret = in_a_cluster;
+	else
+		lwfree(in_a_cluster);
+
+	return failed ? LW_FAILURE : LW_SUCCESS;
+}
+
 int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps, uint32_t min_points,
-                 char **in_a_cluster_ret) {
+                 char **in_a_cluster_ret, DBSCANTaskRunner *runner) {
+	uint32_t num_threads = runner ? runner->NumberOfThreads() : 1;
+	if (num_geoms >= DBSCAN_PARALLEL_MIN_GEOMS && num_threads > 1) {
+		num_threads = std::min(num_threads, num_geoms / DBSCAN_PARALLEL_BATCH_SIZE);
+		return union_dbscan_parallel(geoms, num_geoms, uf, eps, min_points, in_a_cluster_ret, runner,
+		                             num_threads);
+	}
 	if (min_points <= 1)
 		return union_dbscan_minpoints_1(geoms, num_geoms, uf, eps, in_a_cluster_ret);
 	else
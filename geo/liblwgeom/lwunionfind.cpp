@@ -151,6 +151,73 @@ uint32_t *UF_get_collapsed_cluster_ids(UNIONFIND *uf, const char *is_in_cluster)
 	return new_ids;
 }
 
+UNIONFIND_CONCURRENT *UF_concurrent_create(uint32_t N) {
+	uint32_t i;
+	UNIONFIND_CONCURRENT *uf = (UNIONFIND_CONCURRENT *)lwalloc(sizeof(UNIONFIND_CONCURRENT));
+	uf->N = N;
+	uf->parents = new std::atomic<uint32_t>[N];
+
+	for (i = 0; i < N; i++) {
+		uf->parents[i].store(i, std::memory_order_relaxed);
+	}
+
+	return uf;
+}
+
+void UF_concurrent_destroy(UNIONFIND_CONCURRENT *uf) {
+	delete[] uf->parents;
+	lwfree(uf);
+}
+
+uint32_t UF_concurrent_find(UNIONFIND_CONCURRENT *uf, uint32_t i) {
+	while (true) {
+		uint32_t parent = uf->parents[i].load(std::memory_order_acquire);
+		if (parent == i) {
+			return i;
+		}
+		uint32_t grandparent = uf->parents[parent].load(std::memory_order_acquire);
+		if (grandparent != parent) {
+			/* Path halving: losing the race to another thread only leaves a longer path */
+			uf->parents[i].compare_exchange_weak(parent, grandparent, std::memory_order_release,
+			                                     std::memory_order_relaxed);
+		}
+		i = grandparent;
+	}
+}
+
+void UF_concurrent_union(UNIONFIND_CONCURRENT *uf, uint32_t i, uint32_t j) {
+	while (true) {
+		uint32_t a = UF_concurrent_find(uf, i);
+		uint32_t b = UF_concurrent_find(uf, j);
+
+		if (a == b) {
+			return;
+		}
+
+		/* Link the larger root under the smaller one */
+		if (a > b) {
+			uint32_t tmp = a;
+			a = b;
+			b = tmp;
+		}
+		uint32_t expected = b;
+		if (uf->parents[b].compare_exchange_strong(expected, a, std::memory_order_acq_rel)) {
+			return;
+		}
+		/* b was linked by another thread in the meantime, look for the roots again */
+	}
+}
+
+void UF_concurrent_collect(UNIONFIND_CONCURRENT *cuf, UNIONFIND *uf) {
+	uint32_t i;
+	for (i = 0; i < cuf->N; i++) {
+		uint32_t root = UF_concurrent_find(cuf, i);
+		if (root != i) {
+			UF_union(uf, root, i);
+		}
+	}
+}
+
 static int cmp_int(const void *a, const void *b) {
 	if (*((uint32_t *)a) > *((uint32_t *)b)) {
 		return 1;
@@ -146,8 +146,8 @@ void wkt_yyerror(const char *str);
 int wkt_yylex(void);
 
 
-/* Declare the global parser variable */
-LWGEOM_PARSER_RESULT global_parser_result;
+/* Declare the global parser variable, one per thread so concurrent parses never share state */
+thread_local LWGEOM_PARSER_RESULT global_parser_result;
 
 /* Turn on/off verbose parsing (turn off for production) */
 int wkt_yydebug = 0;
@@ -171,8 +171,9 @@ void wkt_yyerror(__attribute__((__unused__)) const char *str)
 
 /**
 * Parse a WKT geometry string into an LWGEOM structure. Note that this
-* process uses globals and is not re-entrant, so don't call it within itself
-* (eg, from within other functions in lwin_wkt.c) or from a threaded program.
+* process uses thread-local globals and is not re-entrant, so don't call it
+* within itself (eg, from within other functions in lwin_wkt.c). Different
+* threads may parse concurrently.
 * Note that parser_result.wkinput picks up a reference to wktstr.
 */
 int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int parser_check_flags)
@@ -1639,15 +1640,15 @@ int yyparse ();
 
 
 /* The look-ahead symbol.  */
-int yychar;
+thread_local int yychar;
 
 /* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
+thread_local YYSTYPE yylval;
 
 /* Number of syntax errors so far.  */
-int yynerrs;
+thread_local int yynerrs;
 /* Location data for the look-ahead symbol.  */
-YYLTYPE yylloc;
+thread_local YYLTYPE yylloc;
 
 
 
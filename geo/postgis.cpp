@@ -7,6 +7,7 @@
 #include "postgis/lwgeom_functions_analytic.hpp"
 #include "postgis/lwgeom_functions_basic.hpp"
 #include "postgis/lwgeom_geos.hpp"
+#include "postgis/lwgeom_geos_prepared.hpp"
 #include "postgis/lwgeom_in_geohash.hpp"
 #include "postgis/lwgeom_inout.hpp"
 #include "postgis/lwgeom_ogc.hpp"
@@ -27,10 +28,18 @@ GSERIALIZED *Postgis::LWGEOM_getGserialized(const void *base, size_t size) {
 	return duckdb::LWGEOM_getGserialized(base, size);
 }
 
+LWGEOM *Postgis::LWGEOM_getLwgeom(const void *base, size_t size) {
+	return duckdb::LWGEOM_getLwgeom(base, size);
+}
+
 char *Postgis::LWGEOM_base(GSERIALIZED *gser) {
 	return duckdb::LWGEOM_base(gser);
 }
 
+string_t Postgis::LWGEOM_base(GSERIALIZED *gser, Vector &result) {
+	return duckdb::LWGEOM_base(gser, result);
+}
+
 string Postgis::LWGEOM_asBinary(const void *data, size_t size) {
 	return duckdb::LWGEOM_asBinary(data, size);
 }
@@ -63,6 +72,10 @@ void Postgis::LWGEOM_free(GSERIALIZED *gser) {
 	duckdb::LWGEOM_free(gser);
 }
 
+void Postgis::LWGEOM_free(LWGEOM *lwgeom) {
+	duckdb::LWGEOM_free(lwgeom);
+}
+
 GSERIALIZED *Postgis::LWGEOM_makepoint(double x, double y) {
 	return duckdb::LWGEOM_makepoint(x, y);
 }
@@ -175,6 +188,37 @@ bool Postgis::LWGEOM_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double dist
 	return duckdb::LWGEOM_dwithin(geom1, geom2, distance);
 }
 
+bool Postgis::geography_dwithin(GSERIALIZED *geom1, GSERIALIZED *geom2, double tolerance, bool use_spheroid) {
+	return duckdb::geography_dwithin(geom1, geom2, tolerance, use_spheroid);
+}
+
+bool Postgis::geography_dwithin_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, double tolerance,
+                                       bool use_spheroid) {
+	return duckdb::geography_dwithin_cached(cache, geom, tolerance, use_spheroid);
+}
+
+bool Postgis::geography_dwithin_box_reject(const GBOX *box1, bool edges1, const GBOX *box2, bool edges2,
+                                           int32_t srid, double tolerance, bool use_spheroid) {
+	return duckdb::geography_dwithin_box_reject(box1, edges1, box2, edges2, srid, tolerance, use_spheroid);
+}
+
+PrepGeomCache *Postgis::GetPrepGeomCache(GSERIALIZED *geom) {
+	return duckdb::GetPrepGeomCache(geom);
+}
+
+void Postgis::PrepGeomCacheFree(PrepGeomCache *cache) {
+	duckdb::PrepGeomCacheFree(cache);
+}
+
+bool Postgis::prepared_predicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate) {
+	return duckdb::prepared_predicate(cache, geom, predicate);
+}
+
+bool Postgis::prepared_predicate_point(PrepGeomCache *cache, double x, double y, int32_t srid,
+                                       PreparedPredicate predicate, bool *result) {
+	return duckdb::prepared_predicate_point(cache, x, y, srid, predicate, result);
+}
+
 double Postgis::ST_Area(GSERIALIZED *geom) {
 	return duckdb::ST_Area(geom);
 }
@@ -207,6 +251,10 @@ double Postgis::geography_azimuth(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return duckdb::geography_azimuth(geom1, geom2);
 }
 
+double Postgis::geography_azimuth(const POINT2D *point1, const POINT2D *point2, int32_t srid) {
+	return duckdb::geography_azimuth(point1, point2, srid);
+}
+
 double Postgis::LWGEOM_length2d_linestring(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_length2d_linestring(geom);
 }
@@ -219,6 +267,14 @@ GSERIALIZED *Postgis::LWGEOM_envelope(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_envelope(geom);
 }
 
+GSERIALIZED *Postgis::LWGEOM_envelope_box(const GBOX *box, int32_t srid) {
+	return duckdb::LWGEOM_envelope_box(box, srid);
+}
+
+bool Postgis::LWGEOM_calculate_gbox(GSERIALIZED *geom, GBOX *box) {
+	return duckdb::LWGEOM_calculate_gbox(geom, box);
+}
+
 double Postgis::LWGEOM_maxdistance2d_linestring(GSERIALIZED *geom1, GSERIALIZED *geom2) {
 	return duckdb::LWGEOM_maxdistance2d_linestring(geom1, geom2);
 }
@@ -235,6 +291,11 @@ std::vector<int> Postgis::ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int nelems,
 	return duckdb::ST_ClusterDBSCAN(gserArray, nelems, tolerance, minpoints);
 }
 
+std::vector<int> Postgis::ST_ClusterDBSCAN(LWGEOM *geoms[], int nelems, double tolerance, int minpoints,
+                                           DBSCANTaskRunner *runner) {
+	return duckdb::ST_ClusterDBSCAN(geoms, nelems, tolerance, minpoints, runner);
+}
+
 int Postgis::LWGEOM_dimension(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_dimension(geom);
 }
@@ -251,6 +312,10 @@ std::string Postgis::geometry_geometrytype(GSERIALIZED *geom) {
 	return duckdb::geometry_geometrytype(geom);
 }
 
+const std::string &Postgis::geometry_geometrytype(uint8_t type) {
+	return duckdb::geometry_geometrytype(type);
+}
+
 bool Postgis::LWGEOM_isclosed(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_isclosed(geom);
 }
@@ -263,6 +328,10 @@ bool Postgis::LWGEOM_isempty(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_isempty(geom);
 }
 
+bool Postgis::LWGEOM_isempty(LWGEOM *lwgeom) {
+	return duckdb::LWGEOM_isempty(lwgeom);
+}
+
 bool Postgis::LWGEOM_isring(GSERIALIZED *geom) {
 	return duckdb::LWGEOM_isring(geom);
 }
@@ -303,6 +372,24 @@ double Postgis::geography_distance(GSERIALIZED *geom1, GSERIALIZED *geom2, bool
 	return duckdb::geography_distance(geom1, geom2, use_spheroid);
 }
 
+CircTreeGeomCache *Postgis::GetCircTreeGeomCache(GSERIALIZED *geom) {
+	return duckdb::GetCircTreeGeomCache(geom);
+}
+
+void Postgis::CircTreeGeomCacheFree(CircTreeGeomCache *cache) {
+	duckdb::CircTreeGeomCacheFree(cache);
+}
+
+double Postgis::geography_distance_cached(const CircTreeGeomCache *cache, GSERIALIZED *geom, bool use_spheroid) {
+	return duckdb::geography_distance_cached(cache, geom, use_spheroid);
+}
+
+void Postgis::geography_distance_points(const double *lon1, const double *lat1, const double *lon2,
+                                        const double *lat2, size_t count, int32_t srid, bool use_spheroid,
+                                        double *distances) {
+	duckdb::geography_distance_points(lon1, lat1, lon2, lat2, count, srid, use_spheroid, distances);
+}
+
 GSERIALIZED *Postgis::centroid(GSERIALIZED *geom) {
 	return duckdb::centroid(geom);
 }
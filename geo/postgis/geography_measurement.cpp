@@ -91,6 +91,228 @@ double geography_distance(GSERIALIZED *g1, GSERIALIZED *g2, bool use_spheroid) {
 	return distance;
 }
 
+/*
+ ** geography_distance_cached(CircTreeGeomCache *cache, GSERIALIZED *g, boolean use_spheroid)
+ ** geography_distance with the tree of one argument built once and reused across calls
+ ** returns double distance in meters
+ */
+double geography_distance_cached(const CircTreeGeomCache *cache, GSERIALIZED *g, bool use_spheroid) {
+	double distance;
+	SPHEROID s;
+
+	gserialized_error_if_srid_mismatch(cache->gser, g, __func__);
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(gserialized_get_srid(cache->gser), &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Return NULL on empty arguments. */
+	if (gserialized_is_empty(cache->gser) || gserialized_is_empty(g)) {
+		PG_ERROR_NULL();
+	}
+
+	geography_tree_distance_cached(cache, g, &s, FP_TOLERANCE, &distance);
+
+	/* Knock off any funny business at the nanometer level, ticket #2168 */
+	distance = round(distance * INVMINDIST) / INVMINDIST;
+
+	/* Something went wrong, negative return... should already be eloged, return NULL */
+	if (distance < 0.0) {
+		PG_ERROR_NULL();
+	}
+
+	return distance;
+}
+
+/*
+ ** geography_distance_points(lon1[], lat1[], lon2[], lat2[], count, srid, boolean use_spheroid, distances[])
+ ** geography_distance of count pairs of points given as coordinate arrays, without building
+ ** a GSERIALIZED or a tree per point. Same result as geography_distance on each pair: the
+ ** tree distance of two single point trees is the distance between the two points.
+ ** returns double distances in meters
+ */
+void geography_distance_points(const double *lon1, const double *lat1, const double *lon2, const double *lat2,
+                               size_t count, int32_t srid, bool use_spheroid, double *distances) {
+	SPHEROID s;
+	size_t i;
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	for (i = 0; i < count; i++) {
+		GEOGRAPHIC_POINT g1, g2;
+		double distance;
+
+		geographic_point_init(lon1[i], lat1[i], &g1);
+		geographic_point_init(lon2[i], lat2[i], &g2);
+
+		/* Spherical case */
+		if (s.a == s.b)
+			distance = s.radius * sphere_distance(&g1, &g2);
+		else
+			distance = spheroid_distance(&g1, &g2, &s);
+
+		/* Knock off any funny business at the nanometer level, ticket #2168 */
+		distances[i] = round(distance * INVMINDIST) / INVMINDIST;
+	}
+}
+
+/*
+ ** geography_dwithin(GSERIALIZED *g1, GSERIALIZED *g2, double tolerance, boolean use_spheroid)
+ ** returns true if the distance between g1 and g2 is at most tolerance meters. The tolerance
+ ** is passed down to the tree traversal, which stops at the first pair of nodes found within it.
+ */
+bool geography_dwithin(GSERIALIZED *g1, GSERIALIZED *g2, double tolerance, bool use_spheroid) {
+	double distance;
+	SPHEROID s;
+
+	gserialized_error_if_srid_mismatch(g1, g2, __func__);
+
+	/* Zero or negative tolerance is pointless */
+	if (tolerance < 0) {
+		throw "Tolerance cannot be less than zero\n";
+	}
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(gserialized_get_srid(g1), &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Return false on empty arguments. */
+	if (gserialized_is_empty(g1) || gserialized_is_empty(g2)) {
+		return false;
+	}
+
+	if (LW_FAILURE == geography_tree_distance(g1, g2, &s, tolerance, &distance)) {
+		throw "geography_dwithin: failed to calculate distance";
+	}
+
+	return (distance <= tolerance);
+}
+
+/*
+ ** geography_dwithin_cached(CircTreeGeomCache *cache, GSERIALIZED *g, double tolerance, boolean use_spheroid)
+ ** geography_dwithin with the tree of one argument built once and reused across calls
+ */
+bool geography_dwithin_cached(const CircTreeGeomCache *cache, GSERIALIZED *g, double tolerance, bool use_spheroid) {
+	double distance;
+	SPHEROID s;
+
+	gserialized_error_if_srid_mismatch(cache->gser, g, __func__);
+
+	/* Zero or negative tolerance is pointless */
+	if (tolerance < 0) {
+		throw "Tolerance cannot be less than zero\n";
+	}
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(gserialized_get_srid(cache->gser), &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Return false on empty arguments. */
+	if (gserialized_is_empty(cache->gser) || gserialized_is_empty(g)) {
+		return false;
+	}
+
+	if (LW_FAILURE == geography_tree_distance_cached(cache, g, &s, tolerance, &distance)) {
+		throw "geography_dwithin: failed to calculate distance";
+	}
+
+	return (distance <= tolerance);
+}
+
+/*
+ ** Grow the longitude/latitude box of the vertices of a geography so that it also holds its
+ ** great circle edges, which bulge towards the pole between two vertices. An edge between two
+ ** vertices at most w degrees of longitude apart and at most L degrees of latitude from the
+ ** equator stays below atan(tan(L) / cos(w / 2)). Returns LW_FAILURE if the box is 180 degrees
+ ** wide or more, where an edge may as well leave the box through the antimeridian.
+ */
+static int geography_box_add_edges(GBOX *box) {
+	double half_width = deg2rad(box->xmax - box->xmin) / 2.0;
+
+	if (box->xmax - box->xmin >= 180.0)
+		return LW_FAILURE;
+
+	if (box->ymax > 0.0)
+		box->ymax = FP_MIN(90.0, rad2deg(atan(tan(deg2rad(box->ymax)) / cos(half_width))));
+	if (box->ymin < 0.0)
+		box->ymin = FP_MAX(-90.0, -rad2deg(atan(tan(deg2rad(-box->ymin)) / cos(half_width))));
+	return LW_SUCCESS;
+}
+
+/*
+ ** geography_dwithin_box_reject(GBOX *box1, boolean edges1, GBOX *box2, boolean edges2, srid, double tolerance,
+ **                              boolean use_spheroid)
+ ** returns true if the geographies of the longitude/latitude vertex boxes box1 and box2 are
+ ** certainly further than tolerance meters apart, edgesN telling whether the geography has
+ ** edges (anything but points). Returns false when the boxes cannot decide, in which case the
+ ** exact test has to run.
+ */
+bool geography_dwithin_box_reject(const GBOX *box1, bool edges1, const GBOX *box2, bool edges2, int32_t srid,
+                                  double tolerance, bool use_spheroid) {
+	SPHEROID s;
+	GBOX b1 = *box1;
+	GBOX b2 = *box2;
+	double dlat, dlon, span, maxlat, h, radius;
+
+	/* A negative tolerance is an error, left to the exact test */
+	if (tolerance < 0)
+		return false;
+
+	/* Only boxes inside the regular longitude/latitude range can be reasoned about */
+	if (b1.xmin < -180.0 || b1.xmax > 180.0 || b1.ymin < -90.0 || b1.ymax > 90.0 || b2.xmin < -180.0 ||
+	    b2.xmax > 180.0 || b2.ymin < -90.0 || b2.ymax > 90.0 || b1.xmin > b1.xmax || b2.xmin > b2.xmax) {
+		return false;
+	}
+
+	if ((edges1 && geography_box_add_edges(&b1) == LW_FAILURE) ||
+	    (edges2 && geography_box_add_edges(&b2) == LW_FAILURE)) {
+		return false;
+	}
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* Set to sphere if requested */
+	if (!use_spheroid)
+		s.a = s.b = s.radius;
+
+	/* Latitude gap between the boxes */
+	dlat = FP_MAX(0.0, FP_MAX(b2.ymin - b1.ymax, b1.ymin - b2.ymax));
+
+	/* Longitude gap between the boxes, going round the antimeridian when that is shorter */
+	dlon = FP_MAX(0.0, FP_MAX(b2.xmin - b1.xmax, b1.xmin - b2.xmax));
+	if (dlon > 0.0) {
+		span = FP_MAX(b1.xmax, b2.xmax) - FP_MIN(b1.xmin, b2.xmin);
+		dlon = FP_MIN(dlon, 360.0 - span);
+	}
+
+	/* Largest absolute latitude, where a longitude gap is the narrowest */
+	maxlat = FP_MAX(FP_MAX(fabs(b1.ymin), fabs(b1.ymax)), FP_MAX(fabs(b2.ymin), fabs(b2.ymax)));
+
+	/* Haversine lower bound of the central angle between any two points of the boxes */
+	h = POW2(sin(deg2rad(dlat) / 2.0)) + POW2(cos(deg2rad(maxlat)) * sin(deg2rad(dlon) / 2.0));
+	h = 2.0 * asin(sqrt(FP_MIN(1.0, h)));
+
+	/* Smallest radius of curvature of the spheroid, with the same 5% margin as the tree traversal */
+	radius = 0.95 * s.b * s.b / s.a;
+
+	return (h * radius > tolerance);
+}
+
 /*
  ** geography_maxdistance(GSERIALIZED *g1, GSERIALIZED *g2, double tolerance, boolean use_spheroid)
  ** returns double distance in meters
@@ -282,6 +504,20 @@ double geography_azimuth(GSERIALIZED *g1, GSERIALIZED *g2) {
 	return azimuth;
 }
 
+/*
+** geography_azimuth(const POINT2D *p1, const POINT2D *p2, int32_t srid)
+** same as above for two non-empty points read straight from WKB
+*/
+double geography_azimuth(const POINT2D *p1, const POINT2D *p2, int32_t srid) {
+	SPHEROID s;
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(srid, &s);
+
+	/* Calculate the direction, NaN for the same point */
+	return lw_azimuth_spheroid_2d(p1, p2, &s);
+}
+
 /*
 ** geography_length(GSERIALIZED *g)
 ** returns double length in meters
@@ -99,6 +99,61 @@ int geography_tree_distance(const GSERIALIZED *g1, const GSERIALIZED *g2, const
 	return LW_SUCCESS;
 }
 
+CircTreeGeomCache *GetCircTreeGeomCache(GSERIALIZED *gser) {
+	CircTreeGeomCache *cache = (CircTreeGeomCache *)lwalloc(sizeof(CircTreeGeomCache));
+	cache->gser = gser;
+	cache->lwgeom = lwgeom_from_gserialized(gser);
+	/* The tree points into the coordinates of lwgeom, which must outlive it */
+	cache->index = lwgeom_calculate_circ_tree(cache->lwgeom);
+	lwgeom_startpoint(cache->lwgeom, &cache->startpoint);
+	return cache;
+}
+
+void CircTreeGeomCacheFree(CircTreeGeomCache *cache) {
+	if (!cache)
+		return;
+	if (cache->index)
+		circ_tree_free(cache->index);
+	if (cache->lwgeom)
+		lwgeom_free(cache->lwgeom);
+	if (cache->gser)
+		lwfree(cache->gser);
+	lwfree(cache);
+}
+
+/*
+ * Same as geography_tree_distance, with the tree of one argument taken from
+ * the cache instead of being built on every call.
+ */
+int geography_tree_distance_cached(const CircTreeGeomCache *cache, const GSERIALIZED *g, const SPHEROID *s,
+                                   double tolerance, double *distance) {
+	CIRC_NODE *circ_tree = NULL;
+	LWGEOM *lwgeom = NULL;
+	POINT4D pt;
+
+	lwgeom = lwgeom_from_gserialized(g);
+	lwgeom_startpoint(lwgeom, &pt);
+
+	/* Test the cached polygon first, the tree of the other side may not be needed */
+	if (CircTreePIP(cache->index, cache->gser, &pt)) {
+		*distance = 0.0;
+		lwgeom_free(lwgeom);
+		return LW_SUCCESS;
+	}
+
+	circ_tree = lwgeom_calculate_circ_tree(lwgeom);
+	if (CircTreePIP(circ_tree, g, &cache->startpoint)) {
+		*distance = 0.0;
+	} else {
+		/* Calculate tree/tree distance */
+		*distance = circ_tree_distance_tree(cache->index, circ_tree, s, tolerance);
+	}
+
+	circ_tree_free(circ_tree);
+	lwgeom_free(lwgeom);
+	return LW_SUCCESS;
+}
+
 int geography_tree_maxdistance(const GSERIALIZED *g1, const GSERIALIZED *g2, const SPHEROID *s, double tolerance,
                                double *maxdistance) {
 	CIRC_NODE *circ_tree1 = NULL;
@@ -224,6 +224,10 @@ bool LWGEOM_isempty(GSERIALIZED *geom) {
 	return gserialized_is_empty(geom);
 }
 
+bool LWGEOM_isempty(LWGEOM *lwgeom) {
+	return lwgeom_is_empty(lwgeom);
+}
+
 /** number of points in an object */
 int LWGEOM_npoints(GSERIALIZED *geom) {
 	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
@@ -518,10 +522,7 @@ double LWGEOM_length2d_linestring(GSERIALIZED *geom) {
 GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
 	int32_t srid = lwgeom->srid;
-	POINT4D pt;
 	GBOX box;
-	POINTARRAY *pa;
-	GSERIALIZED *result;
 
 	if (lwgeom_is_empty(lwgeom)) {
 		/* must be the EMPTY geometry */
@@ -533,6 +534,15 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 		return geom;
 	}
 
+	lwgeom_free(lwgeom);
+	return LWGEOM_envelope_box(&box, srid);
+}
+
+GSERIALIZED *LWGEOM_envelope_box(const GBOX *box, int32_t srid) {
+	POINT4D pt;
+	POINTARRAY *pa;
+	GSERIALIZED *result;
+
 	/*
 	 * Alter envelope type so that a valid geometry is always
 	 * returned depending upon the size of the geometry. The
@@ -544,22 +554,22 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 	 *     - Otherwise return a POLYGON
 	 */
 
-	if ((box.xmin == box.xmax) && (box.ymin == box.ymax)) {
+	if ((box->xmin == box->xmax) && (box->ymin == box->ymax)) {
 		/* Construct and serialize point */
-		LWPOINT *point = lwpoint_make2d(srid, box.xmin, box.ymin);
+		LWPOINT *point = lwpoint_make2d(srid, box->xmin, box->ymin);
 		result = geometry_serialize(lwpoint_as_lwgeom(point));
 		lwpoint_free(point);
-	} else if ((box.xmin == box.xmax) || (box.ymin == box.ymax)) {
+	} else if ((box->xmin == box->xmax) || (box->ymin == box->ymax)) {
 		LWLINE *line;
 		/* Construct point array */
 		pa = ptarray_construct_empty(0, 0, 2);
 
 		/* Assign coordinates to POINT2D array */
-		pt.x = box.xmin;
-		pt.y = box.ymin;
+		pt.x = box->xmin;
+		pt.y = box->ymin;
 		ptarray_append_point(pa, &pt, LW_TRUE);
-		pt.x = box.xmax;
-		pt.y = box.ymax;
+		pt.x = box->xmax;
+		pt.y = box->ymax;
 		ptarray_append_point(pa, &pt, LW_TRUE);
 
 		/* Construct and serialize linestring */
@@ -573,20 +583,20 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 		ppa[0] = pa;
 
 		/* Assign coordinates to POINT2D array */
-		pt.x = box.xmin;
-		pt.y = box.ymin;
+		pt.x = box->xmin;
+		pt.y = box->ymin;
 		ptarray_append_point(pa, &pt, LW_TRUE);
-		pt.x = box.xmin;
-		pt.y = box.ymax;
+		pt.x = box->xmin;
+		pt.y = box->ymax;
 		ptarray_append_point(pa, &pt, LW_TRUE);
-		pt.x = box.xmax;
-		pt.y = box.ymax;
+		pt.x = box->xmax;
+		pt.y = box->ymax;
 		ptarray_append_point(pa, &pt, LW_TRUE);
-		pt.x = box.xmax;
-		pt.y = box.ymin;
+		pt.x = box->xmax;
+		pt.y = box->ymin;
 		ptarray_append_point(pa, &pt, LW_TRUE);
-		pt.x = box.xmin;
-		pt.y = box.ymin;
+		pt.x = box->xmin;
+		pt.y = box->ymin;
 		ptarray_append_point(pa, &pt, LW_TRUE);
 
 		/* Construct polygon  */
@@ -598,6 +608,17 @@ GSERIALIZED *LWGEOM_envelope(GSERIALIZED *geom) {
 	return result;
 }
 
+/**
+ * Compute the 2D cartesian bounding box of a geometry. Returns false for
+ * empty geometries.
+ */
+bool LWGEOM_calculate_gbox(GSERIALIZED *geom, GBOX *box) {
+	LWGEOM *lwgeom = lwgeom_from_gserialized(geom);
+	bool success = !lwgeom_is_empty(lwgeom) && lwgeom_calculate_gbox(lwgeom, box) == LW_SUCCESS;
+	lwgeom_free(lwgeom);
+	return success;
+}
+
 /**
  Maximum 2d distance between objects in geom1 and geom2.
  */
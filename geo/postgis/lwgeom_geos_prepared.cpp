@@ -0,0 +1,183 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************
+ *
+ * Copyright 2008 Paul Ramsey <pramsey@cleverelephant.ca>
+ * Copyright 2007 Refractions Research Inc.
+ *
+ **********************************************************************/
+
+#include "postgis/lwgeom_geos_prepared.hpp"
+
+#include "geos_c.hpp"
+#include "liblwgeom/gserialized.hpp"
+#include "libpgcommon/lwgeom_pg.hpp"
+#include "postgis/lwgeom_geos.hpp"
+
+namespace duckdb {
+
+struct PrepGeomCache {
+	GSERIALIZED *gser;
+	int32_t srid;
+	bool is_empty;
+	bool has_gbox;
+	GBOX gbox;
+	GEOSGeometry *geom;
+	const GEOSPreparedGeometry *prepared_geom;
+};
+
+PrepGeomCache *GetPrepGeomCache(GSERIALIZED *gser) {
+	PrepGeomCache *cache = (PrepGeomCache *)lwalloc(sizeof(PrepGeomCache));
+	cache->gser = gser;
+	cache->srid = gserialized_get_srid(gser);
+	cache->is_empty = gserialized_is_empty(gser);
+	cache->has_gbox = !cache->is_empty && gserialized_get_gbox_p(gser, &cache->gbox);
+	cache->geom = NULL;
+	cache->prepared_geom = NULL;
+
+	/* Empty geometries short-circuit every predicate, there is nothing to prepare */
+	if (cache->is_empty)
+		return cache;
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	cache->geom = POSTGIS2GEOS(gser);
+	if (!cache->geom) {
+		PrepGeomCacheFree(cache);
+		throw "Prepared geometry could not be converted to GEOS";
+	}
+	cache->prepared_geom = GEOSPrepare(cache->geom);
+	if (!cache->prepared_geom) {
+		PrepGeomCacheFree(cache);
+		throw "GEOSPrepare";
+	}
+	return cache;
+}
+
+void PrepGeomCacheFree(PrepGeomCache *cache) {
+	if (cache->prepared_geom)
+		GEOSPreparedGeom_destroy(cache->prepared_geom);
+	if (cache->geom)
+		GEOSGeom_destroy(cache->geom);
+	lwfree(cache->gser);
+	lwfree(cache);
+}
+
+bool prepared_predicate(PrepGeomCache *cache, GSERIALIZED *geom, PreparedPredicate predicate) {
+	GBOX box;
+	GEOSGeometry *g;
+	char result;
+
+	gserialized_error_if_srid_mismatch_reference(geom, cache->srid, __func__);
+
+	/* A.Disjoint(Empty) == TRUE, every other predicate is FALSE */
+	if (cache->is_empty || gserialized_is_empty(geom))
+		return predicate == PreparedPredicate::DISJOINT;
+
+	/* short-circuit: the bounding boxes rule out the predicate */
+	if (cache->has_gbox && gserialized_get_gbox_p(geom, &box)) {
+		switch (predicate) {
+		case PreparedPredicate::CONTAINS:
+		case PreparedPredicate::COVERS:
+			if (!gbox_contains_2d(&cache->gbox, &box))
+				return false;
+			break;
+		case PreparedPredicate::WITHIN:
+		case PreparedPredicate::COVEREDBY:
+			if (!gbox_contains_2d(&box, &cache->gbox))
+				return false;
+			break;
+		case PreparedPredicate::INTERSECTS:
+			if (gbox_overlaps_2d(&cache->gbox, &box) == LW_FALSE)
+				return false;
+			break;
+		case PreparedPredicate::DISJOINT:
+			if (gbox_overlaps_2d(&cache->gbox, &box) == LW_FALSE)
+				return true;
+			break;
+		}
+	}
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	g = POSTGIS2GEOS(geom);
+	if (!g)
+		throw "Geometry could not be converted to GEOS";
+
+	switch (predicate) {
+	case PreparedPredicate::CONTAINS:
+		result = GEOSPreparedContains(cache->prepared_geom, g);
+		break;
+	case PreparedPredicate::WITHIN:
+		result = GEOSPreparedWithin(cache->prepared_geom, g);
+		break;
+	case PreparedPredicate::COVERS:
+		result = GEOSPreparedCovers(cache->prepared_geom, g);
+		break;
+	case PreparedPredicate::COVEREDBY:
+		result = GEOSPreparedCoveredBy(cache->prepared_geom, g);
+		break;
+	case PreparedPredicate::INTERSECTS:
+		result = GEOSPreparedIntersects(cache->prepared_geom, g);
+		break;
+	default:
+		result = GEOSPreparedDisjoint(cache->prepared_geom, g);
+		break;
+	}
+	GEOSGeom_destroy(g);
+
+	if (result == 2)
+		throw "GEOSPrepared predicate";
+
+	return result;
+}
+
+bool prepared_predicate_point(PrepGeomCache *cache, double x, double y, int32_t srid, PreparedPredicate predicate,
+                              bool *result) {
+	char rv;
+
+	if (cache->is_empty || cache->srid != srid)
+		return false;
+	/* Only a point can be within or covered by a point: no shortcut */
+	if (predicate == PreparedPredicate::WITHIN || predicate == PreparedPredicate::COVEREDBY)
+		return false;
+
+	/* short-circuit: the point is outside of the bounding box */
+	if (cache->has_gbox &&
+	    (x < cache->gbox.xmin || x > cache->gbox.xmax || y < cache->gbox.ymin || y > cache->gbox.ymax)) {
+		*result = predicate == PreparedPredicate::DISJOINT;
+		return true;
+	}
+
+	initGEOS(lwnotice, lwgeom_geos_error);
+
+	/* A point is covered exactly when it intersects */
+	if (predicate == PreparedPredicate::CONTAINS)
+		rv = GEOSPreparedContainsXY(cache->prepared_geom, x, y);
+	else
+		rv = GEOSPreparedIntersectsXY(cache->prepared_geom, x, y);
+
+	if (rv == 2)
+		throw "GEOSPrepared predicate";
+
+	*result = predicate == PreparedPredicate::DISJOINT ? !rv : rv;
+	return true;
+}
+
+} // namespace duckdb
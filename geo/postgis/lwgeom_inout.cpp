@@ -24,6 +24,8 @@
 
 #include "postgis/lwgeom_inout.hpp"
 
+#include "duckdb/common/types/vector.hpp"
+
 #include "liblwgeom/gserialized.hpp"
 #include "liblwgeom/liblwgeom_internal.hpp"
 #include "libpgcommon/lwgeom_pg.hpp"
@@ -120,6 +122,10 @@ GSERIALIZED *LWGEOM_getGserialized(const void *base, size_t size) {
 	return ret;
 }
 
+LWGEOM *LWGEOM_getLwgeom(const void *base, size_t size) {
+	return lwgeom_from_wkb(static_cast<const uint8_t *>(base), size, LW_PARSER_CHECK_NONE);
+}
+
 size_t LWGEOM_size(GSERIALIZED *gser) {
 	LWGEOM *lwgeom = lwgeom_from_gserialized(gser);
 	if (lwgeom == NULL) {
@@ -142,6 +148,28 @@ char *LWGEOM_base(GSERIALIZED *gser) {
 	return (char *)buffer;
 }
 
+/*
+ * Same as LWGEOM_base, but the WKB is written straight into the string heap
+ * of the result vector, so the geometry is deserialized only once.
+ */
+string_t LWGEOM_base(GSERIALIZED *gser, Vector &result) {
+	LWGEOM *lwgeom = lwgeom_from_gserialized(gser);
+	if (lwgeom == NULL) {
+		return string_t();
+	}
+
+	auto buf_size = lwgeom_to_wkb_size(lwgeom, WKB_EXTENDED);
+	auto str = StringVector::EmptyString(result, buf_size);
+	auto written_size = lwgeom_to_wkb_write_buf(lwgeom, WKB_EXTENDED, (uint8_t *)str.GetDataWriteable());
+	lwgeom_free(lwgeom);
+	if (written_size != (ptrdiff_t)buf_size) {
+		lwerror("Output WKB is not the same size as the allocated buffer.");
+		return string_t();
+	}
+	str.Finalize();
+	return str;
+}
+
 // std::string LWGEOM_asText(const void *base, size_t size, size_t max_digits) {
 // 	std::string rstr = "";
 // 	LWGEOM *lwgeom = lwgeom_from_wkb(static_cast<const uint8_t *>(base), size, LW_PARSER_CHECK_NONE);
@@ -214,4 +242,10 @@ void LWGEOM_free(GSERIALIZED *gser) {
 	}
 }
 
+void LWGEOM_free(LWGEOM *lwgeom) {
+	if (lwgeom) {
+		lwgeom_free(lwgeom);
+	}
+}
+
 } // namespace duckdb
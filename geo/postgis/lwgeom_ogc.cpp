@@ -238,6 +238,10 @@ std::string geometry_geometrytype(GSERIALIZED *gser) {
 	return stTypeName[gserialized_get_type(gser)];
 }
 
+const std::string &geometry_geometrytype(uint8_t type) {
+	return stTypeName[type <= TINTYPE ? type : 0];
+}
+
 /**
  * @brief IsClosed(GEOMETRY) if geometry is a linestring then returns
  * 		startpoint == endpoint.  If its not a linestring then return NULL.
@@ -35,9 +35,46 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 	if (ngeoms <= 0) {
 		return {};
 	}
+	int i;
+	LWGEOM **geoms = (LWGEOM **)lwalloc(ngeoms * sizeof(LWGEOM *));
+	for (i = 0; i < ngeoms; i++) {
+		geoms[i] = lwgeom_from_gserialized(gserArray[i]);
+
+		if (!geoms[i]) {
+			while (i-- > 0) {
+				lwgeom_free(geoms[i]);
+			}
+			lwfree(geoms);
+			lwerror("Error reading geometry.");
+			return {};
+		}
+	}
+
+	std::vector<int> clusters;
+	try {
+		clusters = ST_ClusterDBSCAN(geoms, ngeoms, tolerance, minpoints);
+	} catch (...) {
+		for (i = 0; i < ngeoms; i++) {
+			lwgeom_free(geoms[i]);
+		}
+		lwfree(geoms);
+		throw;
+	}
+
+	for (i = 0; i < ngeoms; i++) {
+		lwgeom_free(geoms[i]);
+	}
+	lwfree(geoms);
+	return clusters;
+}
+
+std::vector<int> ST_ClusterDBSCAN(LWGEOM *geoms[], int ngeoms, double tolerance, int minpoints,
+                                  DBSCANTaskRunner *runner) {
+	if (ngeoms <= 0) {
+		return {};
+	}
 	uint32_t i;
 	uint32_t *result_ids;
-	LWGEOM **geoms;
 	char *is_in_cluster = NULL;
 	UNIONFIND *uf;
 	std::vector<int> clusters(ngeoms, -1);
@@ -54,26 +91,12 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 	}
 
 	initGEOS(lwnotice, lwgeom_geos_error);
-	geoms = (LWGEOM **)lwalloc(ngeoms * sizeof(LWGEOM *));
 	uf = UF_create(ngeoms);
-	for (i = 0; i < ngeoms; i++) {
-		geoms[i] = lwgeom_from_gserialized(gserArray[i]);
 
-		if (!geoms[i]) {
-			/* TODO release memory ? */
-			lwerror("Error reading geometry.");
-			return {};
-		}
-	}
-
-	if (union_dbscan(geoms, ngeoms, uf, tolerance, minpoints, minpoints > 1 ? &is_in_cluster : NULL) == LW_SUCCESS)
+	if (union_dbscan(geoms, ngeoms, uf, tolerance, minpoints, minpoints > 1 ? &is_in_cluster : NULL, runner) ==
+	    LW_SUCCESS)
 		is_error = LW_FALSE;
 
-	for (i = 0; i < ngeoms; i++) {
-		lwgeom_free(geoms[i]);
-	}
-	lwfree(geoms);
-
 	if (is_error) {
 		UF_destroy(uf);
 		if (is_in_cluster)
@@ -82,16 +105,24 @@ std::vector<int> ST_ClusterDBSCAN(GSERIALIZED *gserArray[], int ngeoms, double t
 		return {};
 	}
 
+	/* The collapsed ids follow the roots the union-find picked, which differ between the serial
+	 * and the parallel clustering. Number the clusters in order of first appearance instead. */
 	result_ids = UF_get_collapsed_cluster_ids(uf, is_in_cluster);
+	std::vector<int> renumbered(ngeoms, -1);
+	int num_clusters = 0;
 	for (i = 0; i < ngeoms; i++) {
 		if (minpoints > 1 && !is_in_cluster[i]) {
 			clusters[i] = -1;
 		} else {
-			clusters[i] = result_ids[i];
+			if (renumbered[result_ids[i]] == -1)
+				renumbered[result_ids[i]] = num_clusters++;
+			clusters[i] = renumbered[result_ids[i]];
 		}
 	}
 
 	lwfree(result_ids);
+	if (is_in_cluster)
+		lwfree(is_in_cluster);
 	UF_destroy(uf);
 
 	return clusters;
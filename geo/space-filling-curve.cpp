@@ -0,0 +1,84 @@
+#include "space-filling-curve.hpp"
+
+#include "geohash.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+uint32_t SpaceFillingCurve::Scale(double value, double min, double max) {
+	double scaled = (value - min) / (max - min) * 4294967295.0;
+	/* NaN, and every value of a flat extent, land in the first cell */
+	if (!(scaled > 0)) {
+		return 0;
+	}
+	if (scaled >= 4294967295.0) {
+		return 4294967295U;
+	}
+	return (uint32_t)scaled;
+}
+
+uint32_t SpaceFillingCurve::OrderedBits(double value) {
+	float f = (float)value;
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(uint32_t));
+	/* Flip all the bits of negative values and the sign bit of the others, so that the integers sort as the floats */
+	return (bits & 0x80000000U) ? ~bits : bits | 0x80000000U;
+}
+
+void SpaceFillingCurve::ZOrder(const uint32_t *x, const uint32_t *y, idx_t count, uint64_t *result) {
+	for (idx_t i = 0; i < count; i++) {
+		result[i] = GeoHash::Interleave(x[i], y[i]);
+	}
+}
+
+//! Hilbert index of a cell of the 2^32 x 2^32 grid. The curve is walked from the top level down as a prefix scan over
+//! the bits of the cell: each round combines the state of levels that are twice as far apart, so 32 levels take 5
+//! rounds of shifts and masks. See "Fast Hilbert curve" by rawrunprotected for the 16-bit version this extends.
+static inline uint64_t HilbertIndex(uint32_t x, uint32_t y) {
+	uint32_t A, B, C, D;
+	/* First round, from the cell itself */
+	{
+		uint32_t a = x ^ y;
+		uint32_t b = 0xFFFFFFFFU ^ a;
+		uint32_t c = 0xFFFFFFFFU ^ (x | y);
+		uint32_t d = x & (y ^ 0xFFFFFFFFU);
+		A = a | (b >> 1);
+		B = (a >> 1) ^ a;
+		C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+		D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+	}
+	for (int shift = 2; shift < 16; shift *= 2) {
+		uint32_t a = A;
+		uint32_t b = B;
+		uint32_t c = C;
+		uint32_t d = D;
+		A = (a & (a >> shift)) ^ (b & (b >> shift));
+		B = (a & (b >> shift)) ^ (b & ((a ^ b) >> shift));
+		C ^= (a & (c >> shift)) ^ (b & (d >> shift));
+		D ^= (b & (c >> shift)) ^ ((a ^ b) & (d >> shift));
+	}
+	/* Last round, only the transformation state is needed */
+	{
+		uint32_t a = A;
+		uint32_t b = B;
+		uint32_t c = C;
+		uint32_t d = D;
+		C ^= (a & (c >> 16)) ^ (b & (d >> 16));
+		D ^= (b & (c >> 16)) ^ ((a ^ b) & (d >> 16));
+	}
+	/* Undo the prefix scan and recover the two bits of the index at each level */
+	uint32_t a = C ^ (C >> 1);
+	uint32_t b = D ^ (D >> 1);
+	uint32_t i0 = x ^ y;
+	uint32_t i1 = b | (0xFFFFFFFFU ^ (i0 | a));
+	return GeoHash::Interleave(i1, i0);
+}
+
+void SpaceFillingCurve::Hilbert(const uint32_t *x, const uint32_t *y, idx_t count, uint64_t *result) {
+	for (idx_t i = 0; i < count; i++) {
+		result[i] = HilbertIndex(x[i], y[i]);
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,584 @@
+#include "spatial-join.hpp"
+
+#include "duckdb/common/field_writer.hpp"
+#include "duckdb/common/row_operations/row_operations.hpp"
+#include "duckdb/common/types/row_data_collection.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_any_join.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "geometry.hpp"
+#include "wkb-view.hpp"
+
+#include <geos/geom/Envelope.hpp>
+#include <geos/index/strtree/TemplateSTRtree.hpp>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+//! How a stored geography takes part in the spatial join
+enum class SpatialJoinGeometry : uint8_t {
+	//! A zero-length value, the predicates only match it with another zero-length value
+	ZERO_LENGTH,
+	//! A value that cannot be read, the exact predicate raises on it
+	MALFORMED,
+	//! An empty geometry, it matches nothing
+	EMPTY,
+	//! A geometry with an envelope
+	INDEXED
+};
+
+//! Classify a stored geography and compute its envelope if it has one
+static SpatialJoinGeometry GetGeometryEnvelope(string_t geom, geos::geom::Envelope &envelope) {
+	if (geom.GetSize() == 0) {
+		return SpatialJoinGeometry::ZERO_LENGTH;
+	}
+	WKBView view(geom);
+	if (!view.IsValid()) {
+		return SpatialJoinGeometry::MALFORMED;
+	}
+	GBOX box;
+	if (view.TryGetBBox(box)) {
+		if (box.xmin > box.xmax) {
+			return SpatialJoinGeometry::EMPTY;
+		}
+	} else {
+		auto gser = Geometry::GetGserialized(geom);
+		if (!gser) {
+			return SpatialJoinGeometry::MALFORMED;
+		}
+		bool has_box = Geometry::GeometryBBox(gser, box);
+		Geometry::DestroyGeometry(gser);
+		if (!has_box) {
+			return SpatialJoinGeometry::EMPTY;
+		}
+	}
+	envelope.init(box.xmin, box.xmax, box.ymin, box.ymax);
+	return SpatialJoinGeometry::INDEXED;
+}
+
+//! Replace the column references of an expression by references into the given bindings
+static unique_ptr<Expression> BindToColumns(unique_ptr<Expression> expr, const vector<ColumnBinding> &bindings) {
+	if (expr->type == ExpressionType::BOUND_COLUMN_REF) {
+		auto &colref = (BoundColumnRefExpression &)*expr;
+		for (idx_t i = 0; i < bindings.size(); i++) {
+			if (colref.binding == bindings[i]) {
+				return make_unique<BoundReferenceExpression>(colref.alias, colref.return_type, i);
+			}
+		}
+		throw InternalException("Failed to bind column reference in spatial join");
+	}
+	ExpressionIterator::EnumerateChildren(
+	    *expr, [&](unique_ptr<Expression> &child) { child = BindToColumns(move(child), bindings); });
+	return expr;
+}
+
+//===--------------------------------------------------------------------===//
+// LogicalSpatialJoin
+//===--------------------------------------------------------------------===//
+LogicalSpatialJoin::LogicalSpatialJoin(unique_ptr<Expression> predicate_p, idx_t left_arg_p, double distance_p)
+    : LogicalExtensionOperator(), predicate(move(predicate_p)), left_arg(left_arg_p), distance(distance_p) {
+}
+
+vector<ColumnBinding> LogicalSpatialJoin::GetColumnBindings() {
+	auto bindings = children[0]->GetColumnBindings();
+	auto right_bindings = children[1]->GetColumnBindings();
+	bindings.insert(bindings.end(), right_bindings.begin(), right_bindings.end());
+	return bindings;
+}
+
+void LogicalSpatialJoin::ResolveTypes() {
+	types = children[0]->types;
+	types.insert(types.end(), children[1]->types.begin(), children[1]->types.end());
+}
+
+string LogicalSpatialJoin::ParamsToString() const {
+	return predicate->GetName();
+}
+
+void LogicalSpatialJoin::Serialize(FieldWriter &writer) const {
+	writer.WriteSerializable(*predicate);
+	writer.WriteField<idx_t>(left_arg);
+	writer.WriteField<double>(distance);
+}
+
+unique_ptr<PhysicalOperator> LogicalSpatialJoin::CreatePlan(ClientContext &context, PhysicalPlanGenerator &generator) {
+	auto &function = (BoundFunctionExpression &)*predicate;
+	auto left_geom = BindToColumns(move(function.children[left_arg]), children[0]->GetColumnBindings());
+	auto right_geom = BindToColumns(move(function.children[1 - left_arg]), children[1]->GetColumnBindings());
+	// the exact predicate reads its geometry arguments from the first two columns of the candidate chunk
+	function.children[left_arg] = make_unique<BoundReferenceExpression>(left_geom->return_type, left_arg);
+	function.children[1 - left_arg] = make_unique<BoundReferenceExpression>(right_geom->return_type, 1 - left_arg);
+
+	// build the STR-tree over the smaller side
+	bool build_is_left = children[0]->EstimateCardinality(context) < children[1]->EstimateCardinality(context);
+	auto left = generator.CreatePlan(move(children[0]));
+	auto right = generator.CreatePlan(move(children[1]));
+	if (build_is_left) {
+		return make_unique<PhysicalSpatialJoin>(*this, move(right), move(left), move(right_geom), move(left_geom),
+		                                        move(predicate), left_arg != 0, true, distance,
+		                                        estimated_cardinality);
+	}
+	return make_unique<PhysicalSpatialJoin>(*this, move(left), move(right), move(left_geom), move(right_geom),
+	                                        move(predicate), left_arg == 0, false, distance, estimated_cardinality);
+}
+
+//===--------------------------------------------------------------------===//
+// PhysicalSpatialJoin
+//===--------------------------------------------------------------------===//
+PhysicalSpatialJoin::PhysicalSpatialJoin(LogicalOperator &op, unique_ptr<PhysicalOperator> probe,
+                                         unique_ptr<PhysicalOperator> build, unique_ptr<Expression> probe_geom_p,
+                                         unique_ptr<Expression> build_geom_p, unique_ptr<Expression> predicate_p,
+                                         bool probe_is_first_arg_p, bool build_is_left_p, double distance_p,
+                                         idx_t estimated_cardinality)
+    : PhysicalJoin(op, PhysicalOperatorType::EXTENSION, JoinType::INNER, estimated_cardinality),
+      probe_geom(move(probe_geom_p)), build_geom(move(build_geom_p)), predicate(move(predicate_p)),
+      probe_is_first_arg(probe_is_first_arg_p), build_is_left(build_is_left_p), distance(distance_p) {
+	children.push_back(move(probe));
+	children.push_back(move(build));
+	auto build_types = children[1]->types;
+	build_types.push_back(build_geom->return_type);
+	layout.Initialize(build_types);
+}
+
+string PhysicalSpatialJoin::GetName() const {
+	return "SPATIAL_JOIN";
+}
+
+string PhysicalSpatialJoin::ParamsToString() const {
+	return predicate->GetName();
+}
+
+//! A row of the materialized build side
+struct SpatialJoinBuildRow {
+	data_ptr_t row;
+};
+
+typedef geos::index::strtree::TemplateSTRtree<SpatialJoinBuildRow> SpatialJoinTree;
+
+//! The build rows and the heap of their strings, managed by the buffer manager
+struct SpatialJoinRows {
+	SpatialJoinRows(BufferManager &buffer_manager, const RowLayout &layout) {
+		auto row_width = layout.GetRowWidth();
+		auto block_capacity = MaxValue<idx_t>(STANDARD_VECTOR_SIZE, (Storage::BLOCK_SIZE / row_width) + 1);
+		rows = make_unique<RowDataCollection>(buffer_manager, block_capacity, row_width);
+		// the strings stay pinned, the build rows point into them
+		heap = make_unique<RowDataCollection>(buffer_manager, (idx_t)Storage::BLOCK_SIZE, 1, true);
+	}
+
+	unique_ptr<RowDataCollection> rows;
+	unique_ptr<RowDataCollection> heap;
+};
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+class SpatialJoinGlobalState : public GlobalSinkState {
+public:
+	SpatialJoinGlobalState(BufferManager &buffer_manager, const RowLayout &layout)
+	    : buffer_manager(buffer_manager), data(buffer_manager, layout) {
+	}
+
+	BufferManager &buffer_manager;
+	mutex lock;
+	//! The build side; the last column of every row holds the build geometry
+	SpatialJoinRows data;
+	//! The row blocks, pinned in Finalize so the tree can point into them
+	vector<BufferHandle> pinned_handles;
+	//! The STR-tree over the envelopes of the build geometries, built in Finalize
+	unique_ptr<SpatialJoinTree> tree;
+	//! The number of build rows inserted into the tree
+	idx_t indexed_count = 0;
+	//! The build rows holding a zero-length geometry
+	vector<SpatialJoinBuildRow> zero_length_rows;
+	//! The build rows holding a malformed geometry, paired with every probe row that is not zero-length
+	vector<SpatialJoinBuildRow> malformed_rows;
+	//! A build row whose geometry is not zero-length, paired with malformed probe rows (nullptr if there is none)
+	data_ptr_t any_row = nullptr;
+};
+
+class SpatialJoinLocalState : public LocalSinkState {
+public:
+	SpatialJoinLocalState(ClientContext &context, const Expression &build_geom, const RowLayout &layout)
+	    : executor(context, build_geom), data(BufferManager::GetBufferManager(context), layout),
+	      addresses(LogicalType::POINTER) {
+		geom_chunk.Initialize(Allocator::Get(context), {build_geom.return_type});
+		build_chunk.InitializeEmpty(layout.GetTypes());
+	}
+
+	ExpressionExecutor executor;
+	DataChunk geom_chunk;
+	//! The input columns and the build geometry, as laid out in the build rows
+	DataChunk build_chunk;
+	SpatialJoinRows data;
+	Vector addresses;
+};
+
+unique_ptr<GlobalSinkState> PhysicalSpatialJoin::GetGlobalSinkState(ClientContext &context) const {
+	return make_unique<SpatialJoinGlobalState>(BufferManager::GetBufferManager(context), layout);
+}
+
+unique_ptr<LocalSinkState> PhysicalSpatialJoin::GetLocalSinkState(ExecutionContext &context) const {
+	return make_unique<SpatialJoinLocalState>(context.client, *build_geom, layout);
+}
+
+SinkResultType PhysicalSpatialJoin::Sink(ExecutionContext &context, GlobalSinkState &gstate_p,
+                                         LocalSinkState &lstate_p, DataChunk &input) const {
+	auto &lstate = (SpatialJoinLocalState &)lstate_p;
+	auto count = input.size();
+
+	lstate.geom_chunk.Reset();
+	lstate.executor.ExecuteExpression(input, lstate.geom_chunk.data[0]);
+
+	auto &build_chunk = lstate.build_chunk;
+	vector<UnifiedVectorFormat> build_data(build_chunk.ColumnCount());
+	for (idx_t col_idx = 0; col_idx < input.ColumnCount(); col_idx++) {
+		build_chunk.data[col_idx].Reference(input.data[col_idx]);
+	}
+	build_chunk.data[input.ColumnCount()].Reference(lstate.geom_chunk.data[0]);
+	build_chunk.SetCardinality(count);
+	for (idx_t col_idx = 0; col_idx < build_chunk.ColumnCount(); col_idx++) {
+		build_chunk.data[col_idx].ToUnifiedFormat(count, build_data[col_idx]);
+	}
+
+	auto row_locations = FlatVector::GetData<data_ptr_t>(lstate.addresses);
+	auto handles = lstate.data.rows->Build(count, row_locations, nullptr);
+	RowOperations::Scatter(build_chunk, build_data.data(), layout, lstate.addresses, *lstate.data.heap,
+	                       *FlatVector::IncrementalSelectionVector(), count);
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+void PhysicalSpatialJoin::Combine(ExecutionContext &context, GlobalSinkState &gstate_p,
+                                  LocalSinkState &lstate_p) const {
+	auto &gstate = (SpatialJoinGlobalState &)gstate_p;
+	auto &lstate = (SpatialJoinLocalState &)lstate_p;
+	lock_guard<mutex> guard(gstate.lock);
+	gstate.data.rows->Merge(*lstate.data.rows);
+	gstate.data.heap->Merge(*lstate.data.heap);
+}
+
+SinkFinalizeType PhysicalSpatialJoin::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                               GlobalSinkState &gstate_p) const {
+	auto &gstate = (SpatialJoinGlobalState &)gstate_p;
+	gstate.tree = make_unique<SpatialJoinTree>(10, gstate.data.rows->count);
+
+	auto geom_col = layout.ColumnCount() - 1;
+	auto geom_offset = layout.GetOffsets()[geom_col];
+	auto row_width = layout.GetRowWidth();
+	geos::geom::Envelope envelope;
+	for (auto &block : gstate.data.rows->blocks) {
+		auto handle = gstate.buffer_manager.Pin(block->block);
+		auto row = handle.Ptr();
+		for (idx_t i = 0; i < block->count; i++, row += row_width) {
+			ValidityBytes row_mask(row);
+			if (!row_mask.RowIsValid(geom_col)) {
+				continue;
+			}
+			auto kind = GetGeometryEnvelope(Load<string_t>(row + geom_offset), envelope);
+			if (kind == SpatialJoinGeometry::ZERO_LENGTH) {
+				gstate.zero_length_rows.push_back(SpatialJoinBuildRow {row});
+				continue;
+			}
+			if (!gstate.any_row) {
+				gstate.any_row = row;
+			}
+			if (kind == SpatialJoinGeometry::MALFORMED) {
+				gstate.malformed_rows.push_back(SpatialJoinBuildRow {row});
+			} else if (kind == SpatialJoinGeometry::INDEXED) {
+				gstate.tree->insert(envelope, SpatialJoinBuildRow {row});
+				gstate.indexed_count++;
+			}
+		}
+		gstate.pinned_handles.push_back(move(handle));
+	}
+	// pack the tree now so concurrent probes only ever read it
+	gstate.tree->build();
+	return SinkFinalizeType::READY;
+}
+
+//===--------------------------------------------------------------------===//
+// Operator
+//===--------------------------------------------------------------------===//
+class SpatialJoinOperatorState : public OperatorState {
+public:
+	SpatialJoinOperatorState(ClientContext &context, const Expression &probe_geom, const Expression &predicate)
+	    : probe_executor(context, probe_geom), predicate_executor(context, predicate), initialized(false),
+	      probe_idx(0), probe_row(0), match_idx(0), probe_sel(STANDARD_VECTOR_SIZE), match_sel(STANDARD_VECTOR_SIZE),
+	      build_rows(LogicalType::POINTER) {
+		auto &allocator = Allocator::Get(context);
+		probe_chunk.Initialize(allocator, {probe_geom.return_type});
+		auto &function = (BoundFunctionExpression &)predicate;
+		candidates.Initialize(allocator, {function.children[0]->return_type, function.children[1]->return_type});
+	}
+
+	ExpressionExecutor probe_executor;
+	ExpressionExecutor predicate_executor;
+	//! The probe geometries of the current input chunk
+	DataChunk probe_chunk;
+	UnifiedVectorFormat probe_data;
+	//! Whether the probe geometries of the current input chunk have been computed
+	bool initialized;
+	//! The next probe row to look up in the tree
+	idx_t probe_idx;
+	//! The probe row the pending tree matches belong to
+	idx_t probe_row;
+	//! The tree matches of probe_row that have not been emitted yet
+	vector<SpatialJoinBuildRow> matches;
+	idx_t match_idx;
+	//! Candidate pairs of the current output chunk
+	SelectionVector probe_sel;
+	SelectionVector match_sel;
+	//! The build row of every candidate pair
+	Vector build_rows;
+	DataChunk candidates;
+};
+
+unique_ptr<OperatorState> PhysicalSpatialJoin::GetOperatorState(ExecutionContext &context) const {
+	return make_unique<SpatialJoinOperatorState>(context.client, *probe_geom, *predicate);
+}
+
+OperatorResultType PhysicalSpatialJoin::Execute(ExecutionContext &context, DataChunk &input, DataChunk &chunk,
+                                                GlobalOperatorState &gstate_p, OperatorState &state_p) const {
+	auto &gstate = (SpatialJoinGlobalState &)*sink_state;
+	auto &state = (SpatialJoinOperatorState &)state_p;
+
+	if (!gstate.any_row && gstate.zero_length_rows.empty()) {
+		// no build row can match
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+
+	if (!state.initialized) {
+		state.probe_chunk.Reset();
+		state.probe_executor.ExecuteExpression(input, state.probe_chunk.data[0]);
+		state.probe_chunk.data[0].ToUnifiedFormat(input.size(), state.probe_data);
+		state.probe_idx = 0;
+		state.matches.clear();
+		state.match_idx = 0;
+		state.initialized = true;
+	}
+
+	// collect up to a vector of candidate pairs from the tree
+	auto probe_geoms = (string_t *)state.probe_data.data;
+	auto build_rows = FlatVector::GetData<data_ptr_t>(state.build_rows);
+	geos::geom::Envelope envelope;
+	idx_t candidate_count = 0;
+	while (candidate_count < STANDARD_VECTOR_SIZE) {
+		if (state.match_idx < state.matches.size()) {
+			state.probe_sel.set_index(candidate_count, state.probe_row);
+			build_rows[candidate_count] = state.matches[state.match_idx++].row;
+			candidate_count++;
+			continue;
+		}
+		if (state.probe_idx >= input.size()) {
+			break;
+		}
+		state.probe_row = state.probe_idx++;
+		state.matches.clear();
+		state.match_idx = 0;
+		auto geom_idx = state.probe_data.sel->get_index(state.probe_row);
+		if (!state.probe_data.validity.RowIsValid(geom_idx)) {
+			continue;
+		}
+		// the candidates not found through the tree are checked by the exact predicate as the nested loop would
+		auto kind = GetGeometryEnvelope(probe_geoms[geom_idx], envelope);
+		if (kind == SpatialJoinGeometry::ZERO_LENGTH) {
+			state.matches = gstate.zero_length_rows;
+			continue;
+		}
+		if (kind == SpatialJoinGeometry::MALFORMED && gstate.any_row) {
+			// a single pair is enough for the predicate to raise
+			state.matches.push_back(SpatialJoinBuildRow {gstate.any_row});
+		} else if (kind == SpatialJoinGeometry::INDEXED && gstate.indexed_count > 0) {
+			if (distance > 0) {
+				envelope.expandBy(distance);
+			}
+			gstate.tree->query(envelope, [&](const SpatialJoinBuildRow &row) { state.matches.push_back(row); });
+		}
+		state.matches.insert(state.matches.end(), gstate.malformed_rows.begin(), gstate.malformed_rows.end());
+	}
+	bool finished = state.probe_idx >= input.size() && state.match_idx >= state.matches.size();
+
+	if (candidate_count > 0) {
+		// run the exact predicate over the candidate pairs
+		auto &all_rows = *FlatVector::IncrementalSelectionVector();
+		state.candidates.Reset();
+		auto &probe_arg = state.candidates.data[probe_is_first_arg ? 0 : 1];
+		auto &build_arg = state.candidates.data[probe_is_first_arg ? 1 : 0];
+		probe_arg.Slice(state.probe_chunk.data[0], state.probe_sel, candidate_count);
+		RowOperations::Gather(state.build_rows, all_rows, build_arg, all_rows, candidate_count, layout,
+		                      layout.ColumnCount() - 1);
+		state.candidates.SetCardinality(candidate_count);
+		auto match_count = state.predicate_executor.SelectExpression(state.candidates, state.match_sel);
+
+		// emit the matching pairs in the column order of the original join
+		auto probe_columns = input.ColumnCount();
+		auto build_columns = children[1]->types.size();
+		auto probe_offset = build_is_left ? build_columns : 0;
+		auto build_offset = build_is_left ? 0 : probe_columns;
+		SelectionVector result_sel(match_count);
+		for (idx_t i = 0; i < match_count; i++) {
+			result_sel.set_index(i, state.probe_sel.get_index(state.match_sel.get_index(i)));
+		}
+		for (idx_t col_idx = 0; col_idx < probe_columns; col_idx++) {
+			chunk.data[probe_offset + col_idx].Slice(input.data[col_idx], result_sel, match_count);
+		}
+		for (idx_t col_idx = 0; col_idx < build_columns; col_idx++) {
+			RowOperations::Gather(state.build_rows, state.match_sel, chunk.data[build_offset + col_idx], all_rows,
+			                      match_count, layout, col_idx);
+		}
+		chunk.SetCardinality(match_count);
+	}
+
+	if (finished) {
+		state.initialized = false;
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+	return OperatorResultType::HAVE_MORE_OUTPUT;
+}
+
+//===--------------------------------------------------------------------===//
+// SpatialJoinOptimizer
+//===--------------------------------------------------------------------===//
+//! Whether the expression is a spatial predicate the spatial join can evaluate, and if so its ST_DWithin distance
+static bool IsSpatialJoinPredicate(ClientContext &context, Expression &expr, double &distance) {
+	if (expr.type != ExpressionType::BOUND_FUNCTION) {
+		return false;
+	}
+	auto &function = (BoundFunctionExpression &)expr;
+	auto &name = function.function.name;
+	distance = 0;
+	// the join reads GEOGRAPHY values, the GEOGRAPHY_POINT overloads are evaluated as regular joins
+	if (function.children.size() < 2 || function.children[0]->return_type.id() != LogicalTypeId::BLOB ||
+	    function.children[1]->return_type.id() != LogicalTypeId::BLOB) {
+		return false;
+	}
+	if (name == "st_intersects" || name == "st_contains" || name == "st_within") {
+		return function.children.size() == 2;
+	}
+	if (name == "st_dwithin") {
+		if (function.children.size() != 3 || !function.children[2]->IsFoldable()) {
+			return false;
+		}
+		auto value = ExpressionExecutor::EvaluateScalar(context, *function.children[2]);
+		if (value.IsNull()) {
+			return false;
+		}
+		distance = value.GetValue<double>();
+		return distance >= 0;
+	}
+	return false;
+}
+
+//! Which side (0 = left, 1 = right) an expression reads from, or -1 if it reads from both or none
+static int GetExpressionSide(Expression &expr, const unordered_set<idx_t> &left_tables,
+                             const unordered_set<idx_t> &right_tables) {
+	unordered_set<idx_t> tables;
+	LogicalJoin::GetExpressionBindings(expr, tables);
+	if (tables.empty()) {
+		return -1;
+	}
+	bool reads_left = false;
+	bool reads_right = false;
+	for (auto &table : tables) {
+		reads_left = reads_left || left_tables.find(table) != left_tables.end();
+		reads_right = reads_right || right_tables.find(table) != right_tables.end();
+	}
+	if (reads_left == reads_right) {
+		return -1;
+	}
+	return reads_left ? 0 : 1;
+}
+
+static unique_ptr<LogicalOperator> TryRewriteAnyJoin(ClientContext &context, unique_ptr<LogicalOperator> op) {
+	auto &join = (LogicalAnyJoin &)*op;
+	if (join.join_type != JoinType::INNER || !join.left_projection_map.empty() ||
+	    !join.right_projection_map.empty()) {
+		return op;
+	}
+
+	// split the condition into its conjuncts
+	vector<unique_ptr<Expression>> conditions;
+	if (join.condition->type == ExpressionType::CONJUNCTION_AND) {
+		auto &conjunction = (BoundConjunctionExpression &)*join.condition;
+		for (auto &child : conjunction.children) {
+			conditions.push_back(move(child));
+		}
+	} else {
+		conditions.push_back(move(join.condition));
+	}
+
+	unordered_set<idx_t> left_tables;
+	unordered_set<idx_t> right_tables;
+	LogicalJoin::GetTableReferences(*join.children[0], left_tables);
+	LogicalJoin::GetTableReferences(*join.children[1], right_tables);
+
+	unique_ptr<LogicalSpatialJoin> spatial_join;
+	vector<unique_ptr<Expression>> remaining;
+	for (auto &condition : conditions) {
+		double distance;
+		if (!spatial_join && IsSpatialJoinPredicate(context, *condition, distance)) {
+			auto &function = (BoundFunctionExpression &)*condition;
+			auto first_side = GetExpressionSide(*function.children[0], left_tables, right_tables);
+			auto second_side = GetExpressionSide(*function.children[1], left_tables, right_tables);
+			if (first_side != -1 && second_side != -1 && first_side != second_side) {
+				spatial_join = make_unique<LogicalSpatialJoin>(move(condition), first_side == 0 ? 0 : 1, distance);
+				continue;
+			}
+		}
+		remaining.push_back(move(condition));
+	}
+
+	if (!spatial_join) {
+		// no spatial predicate: restore the original condition
+		if (remaining.size() == 1) {
+			join.condition = move(remaining[0]);
+		} else {
+			auto conjunction = make_unique<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
+			conjunction->children = move(remaining);
+			join.condition = move(conjunction);
+		}
+		return op;
+	}
+
+	spatial_join->estimated_cardinality = join.estimated_cardinality;
+	spatial_join->children.push_back(move(join.children[0]));
+	spatial_join->children.push_back(move(join.children[1]));
+	if (remaining.empty()) {
+		return move(spatial_join);
+	}
+	// the other conjuncts are applied on top of the spatial join
+	auto filter = make_unique<LogicalFilter>();
+	filter->expressions = move(remaining);
+	filter->children.push_back(move(spatial_join));
+	return move(filter);
+}
+
+static void RewriteSpatialJoins(ClientContext &context, unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		RewriteSpatialJoins(context, child);
+	}
+	if (op->type == LogicalOperatorType::LOGICAL_ANY_JOIN) {
+		op = TryRewriteAnyJoin(context, move(op));
+	}
+}
+
+void SpatialJoinOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo *info,
+                                    unique_ptr<LogicalOperator> &plan) {
+	RewriteSpatialJoins(context, plan);
+}
+
+OptimizerExtension SpatialJoinOptimizer::GetOptimizerExtension() {
+	OptimizerExtension extension;
+	extension.optimize_function = SpatialJoinOptimizer::Optimize;
+	return extension;
+}
+
+} // namespace duckdb
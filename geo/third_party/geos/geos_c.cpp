@@ -36,14 +36,33 @@ using geos::geom::Geometry;
 
 // ## GLOBALS ################################################
 
+namespace {
+
+// Owns the context of the current thread and releases it when the thread exits
+struct GEOSThreadContext {
+	GEOSContextHandle_t handle = NULL;
+
+	~GEOSThreadContext() {
+		if (handle) {
+			GEOS_finish_r(handle);
+		}
+	}
+};
+
+thread_local GEOSThreadContext thread_context;
+
+} // namespace
+
 // NOTE: SRID will have to be changed after geometry creation
-GEOSContextHandle_t handle = NULL;
+// Every DuckDB worker thread gets its own context, so the non-reentrant wrappers below never share state.
+thread_local GEOSContextHandle_t handle = NULL;
 
 extern "C" {
 
 void initGEOS(GEOSMessageHandler nf, GEOSMessageHandler ef) {
 	if (!handle) {
-		handle = initGEOS_r(nf, ef);
+		thread_context.handle = initGEOS_r(nf, ef);
+		handle = thread_context.handle;
 	} else {
 		GEOSContext_setNoticeHandler_r(handle, nf);
 		GEOSContext_setErrorHandler_r(handle, ef);
@@ -323,4 +342,48 @@ char GEOSRelatePattern(const Geometry *g1, const Geometry *g2, const char *pat)
 	return GEOSRelatePattern_r(handle, g1, g2, pat);
 }
 
+//-------------------------------------------------------------------
+// Prepared Geometry
+//-------------------------------------------------------------------
+
+const GEOSPreparedGeometry *GEOSPrepare(const Geometry *g) {
+	return GEOSPrepare_r(handle, g);
+}
+
+void GEOSPreparedGeom_destroy(const GEOSPreparedGeometry *pg) {
+	GEOSPreparedGeom_destroy_r(handle, pg);
+}
+
+char GEOSPreparedContains(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedContains_r(handle, pg, g);
+}
+
+char GEOSPreparedContainsXY(const GEOSPreparedGeometry *pg, double x, double y) {
+	return GEOSPreparedContainsXY_r(handle, pg, x, y);
+}
+
+char GEOSPreparedCoveredBy(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedCoveredBy_r(handle, pg, g);
+}
+
+char GEOSPreparedCovers(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedCovers_r(handle, pg, g);
+}
+
+char GEOSPreparedDisjoint(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedDisjoint_r(handle, pg, g);
+}
+
+char GEOSPreparedIntersects(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedIntersects_r(handle, pg, g);
+}
+
+char GEOSPreparedIntersectsXY(const GEOSPreparedGeometry *pg, double x, double y) {
+	return GEOSPreparedIntersectsXY_r(handle, pg, x, y);
+}
+
+char GEOSPreparedWithin(const GEOSPreparedGeometry *pg, const Geometry *g) {
+	return GEOSPreparedWithin_r(handle, pg, g);
+}
+
 } /* extern "C" */
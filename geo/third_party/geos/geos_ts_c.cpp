@@ -17,6 +17,7 @@
  *
  ***********************************************************************/
 
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.hpp>
 #include <geos/geom/Coordinate.hpp>
 #include <geos/geom/CoordinateSequenceFactory.hpp>
 #include <geos/geom/FixedSizeCoordinateSequence.hpp>
@@ -46,12 +47,36 @@
 #include <sstream>
 #include <string>
 
+namespace geos {
+namespace geom {
+namespace prep {
+
+// The geom::prep package is not vendored: a prepared geometry only keeps an IndexedPointInAreaLocator over the rings
+// of a polygonal geometry, which answers the point-in-area tests that dominate predicates against a constant polygon.
+// All other cases are forwarded to the predicates of the base geometry.
+struct PreparedGeometry {
+	explicit PreparedGeometry(const Geometry *g) : base(g) {
+		if (g->isPolygonal() && !g->isEmpty()) {
+			locator.reset(new algorithm::locate::IndexedPointInAreaLocator(*g));
+		}
+	}
+
+	const Geometry *base;
+	//! The ring index is built on the first locate() call, hence mutable
+	mutable std::unique_ptr<algorithm::locate::IndexedPointInAreaLocator> locator;
+};
+
+} // namespace prep
+} // namespace geom
+} // namespace geos
+
 // Some extra magic to make type declarations in geos_c.h work -
 // for cross-checking of types in header.
-#define GEOSGeometry      geos::geom::Geometry
-#define GEOSCoordSequence geos::geom::CoordinateSequence
-#define GEOSBufferParams  geos::operation::buffer::BufferParameters
-#define GEOSSTRtree       geos::index::strtree::SimpleSTRtree
+#define GEOSGeometry         geos::geom::Geometry
+#define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
+#define GEOSCoordSequence    geos::geom::CoordinateSequence
+#define GEOSBufferParams     geos::operation::buffer::BufferParameters
+#define GEOSSTRtree          geos::index::strtree::SimpleSTRtree
 
 #include "geos_c.hpp"
 
@@ -74,6 +99,7 @@ using geos::geom::GeometryFactory;
 using geos::geom::LineString;
 using geos::geom::Polygon;
 using geos::geom::PrecisionModel;
+using geos::geom::prep::PreparedGeometry;
 
 using geos::operation::overlayng::OverlayNG;
 using geos::operation::overlayng::OverlayNGRobust;
@@ -290,6 +316,11 @@ GEOSContextHandle_t GEOS_init_r() {
 	return static_cast<GEOSContextHandle_t>(handle);
 }
 
+void GEOS_finish_r(GEOSContextHandle_t extHandle) {
+	GEOSContextHandleInternal_t *handle = reinterpret_cast<GEOSContextHandleInternal_t *>(extHandle);
+	delete handle;
+}
+
 // Return postgis geometry type index
 int GEOSGeomTypeId_r(GEOSContextHandle_t extHandle, const Geometry *g1) {
 	return execute(extHandle, -1, [&]() { return static_cast<int>(g1->getGeometryTypeId()); });
@@ -872,4 +903,97 @@ char GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, cons
 	});
 }
 
+//-----------------------------------------------------------------
+// Prepared Geometry
+//-----------------------------------------------------------------
+
+// Locate a point against the ring index of a polygonal prepared geometry
+static geos::geom::Location PreparedLocate(const PreparedGeometry *pg, double x, double y) {
+	geos::geom::CoordinateXY pt(x, y);
+	return pg->locator->locate(&pt);
+}
+
+// Whether g is a single non-empty point that can be located against the ring index
+static bool PreparedCanLocate(const PreparedGeometry *pg, const Geometry *g) {
+	return pg->locator && g->getGeometryTypeId() == geos::geom::GEOS_POINT && !g->isEmpty();
+}
+
+const PreparedGeometry *GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g) {
+	return execute(extHandle, [&]() { return static_cast<const PreparedGeometry *>(new PreparedGeometry(g)); });
+}
+
+void GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg) {
+	execute(extHandle, [&]() { delete pg; });
+}
+
+char GEOSPreparedContains_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() {
+		if (PreparedCanLocate(pg, g)) {
+			auto c = g->getCoordinate();
+			return PreparedLocate(pg, c->x, c->y) == geos::geom::Location::INTERIOR;
+		}
+		return pg->base->contains(g);
+	});
+}
+
+char GEOSPreparedContainsXY_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, double x, double y) {
+	return execute(extHandle, 2, [&]() {
+		if (pg->locator) {
+			return PreparedLocate(pg, x, y) == geos::geom::Location::INTERIOR;
+		}
+		GEOSContextHandleInternal_t *handle = reinterpret_cast<GEOSContextHandleInternal_t *>(extHandle);
+		handle->point2d->setXY(x, y);
+		return pg->base->contains(handle->point2d.get());
+	});
+}
+
+char GEOSPreparedCoveredBy_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return pg->base->relate(g, "**F**F***"); });
+}
+
+char GEOSPreparedCovers_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() {
+		if (PreparedCanLocate(pg, g)) {
+			auto c = g->getCoordinate();
+			return PreparedLocate(pg, c->x, c->y) != geos::geom::Location::EXTERIOR;
+		}
+		return pg->base->relate(g, "******FF*");
+	});
+}
+
+char GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() {
+		if (PreparedCanLocate(pg, g)) {
+			auto c = g->getCoordinate();
+			return PreparedLocate(pg, c->x, c->y) == geos::geom::Location::EXTERIOR;
+		}
+		return pg->base->disjoint(g);
+	});
+}
+
+char GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() {
+		if (PreparedCanLocate(pg, g)) {
+			auto c = g->getCoordinate();
+			return PreparedLocate(pg, c->x, c->y) != geos::geom::Location::EXTERIOR;
+		}
+		return pg->base->intersects(g);
+	});
+}
+
+char GEOSPreparedIntersectsXY_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, double x, double y) {
+	return execute(extHandle, 2, [&]() {
+		if (pg->locator) {
+			return PreparedLocate(pg, x, y) != geos::geom::Location::EXTERIOR;
+		}
+		GEOSContextHandleInternal_t *handle = reinterpret_cast<GEOSContextHandleInternal_t *>(extHandle);
+		handle->point2d->setXY(x, y);
+		return pg->base->intersects(handle->point2d.get());
+	});
+}
+
+char GEOSPreparedWithin_r(GEOSContextHandle_t extHandle, const PreparedGeometry *pg, const Geometry *g) {
+	return execute(extHandle, 2, [&]() { return g->contains(pg->base); });
+}
+
 } /* extern "C" */
@@ -130,6 +130,17 @@ typedef struct GEOSSTRtree_t GEOSSTRtree;
 
 #endif
 
+#ifndef GEOSPreparedGeometry
+
+/**
+ * Prepared geometry type.
+ * \see GEOSPrepare()
+ * \see GEOSPreparedGeom_destroy()
+ */
+typedef struct GEOSPrepGeom_t GEOSPreparedGeometry;
+
+#endif
+
 /** \cond */
 
 /*
@@ -200,6 +211,13 @@ extern GEOSContextHandle_t GEOS_DLL GEOS_init_r(void);
  */
 extern GEOSContextHandle_t GEOS_DLL initGEOS_r(GEOSMessageHandler notice_function, GEOSMessageHandler error_function);
 
+/**
+ * Free the memory associated with a \ref GEOSContextHandle_t
+ * when you are finished calling GEOS functions.
+ * \param handle to be freed
+ */
+extern void GEOS_DLL GEOS_finish_r(GEOSContextHandle_t handle);
+
 /* ========== Geometry info ========== */
 
 /** \see GEOSGeomTypeId */
@@ -263,6 +281,46 @@ extern char GEOS_DLL GEOSIntersects_r(GEOSContextHandle_t handle, const GEOSGeom
 extern char GEOS_DLL GEOSRelatePattern_r(GEOSContextHandle_t handle, const GEOSGeometry *g1, const GEOSGeometry *g2,
                                          const char *pat);
 
+/* ========= Prepared Geometry Binary Predicates ========== */
+
+/** \see GEOSPrepare */
+extern const GEOSPreparedGeometry GEOS_DLL *GEOSPrepare_r(GEOSContextHandle_t handle, const GEOSGeometry *g);
+
+/** \see GEOSPreparedGeom_destroy */
+extern void GEOS_DLL GEOSPreparedGeom_destroy_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *g);
+
+/** \see GEOSPreparedContains */
+extern char GEOS_DLL GEOSPreparedContains_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                            const GEOSGeometry *g2);
+
+/** \see GEOSPreparedContainsXY */
+extern char GEOS_DLL GEOSPreparedContainsXY_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1, double x,
+                                              double y);
+
+/** \see GEOSPreparedCoveredBy */
+extern char GEOS_DLL GEOSPreparedCoveredBy_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                             const GEOSGeometry *g2);
+
+/** \see GEOSPreparedCovers */
+extern char GEOS_DLL GEOSPreparedCovers_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                          const GEOSGeometry *g2);
+
+/** \see GEOSPreparedDisjoint */
+extern char GEOS_DLL GEOSPreparedDisjoint_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                            const GEOSGeometry *g2);
+
+/** \see GEOSPreparedIntersects */
+extern char GEOS_DLL GEOSPreparedIntersects_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                              const GEOSGeometry *g2);
+
+/** \see GEOSPreparedIntersectsXY */
+extern char GEOS_DLL GEOSPreparedIntersectsXY_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1, double x,
+                                                double y);
+
+/** \see GEOSPreparedWithin */
+extern char GEOS_DLL GEOSPreparedWithin_r(GEOSContextHandle_t handle, const GEOSPreparedGeometry *pg1,
+                                          const GEOSGeometry *g2);
+
 /* ========== Coordinate Sequence functions ========== */
 
 /** \see GEOSCoordSeq_create */
@@ -1060,6 +1118,116 @@ extern char GEOS_DLL GEOSIntersects(const GEOSGeometry *g1, const GEOSGeometry *
  */
 extern char GEOS_DLL GEOSRelatePattern(const GEOSGeometry *g1, const GEOSGeometry *g2, const char *pat);
 
+///@}
+
+/** @name Prepared Geometry
+ * A \ref GEOSPreparedGeometry is a wrapper around \ref GEOSGeometry
+ * that keeps an index of its rings, so that testing many points or
+ * geometries against the same areal geometry does not redo the
+ * point-in-area work for every call.
+ *
+ * The prepared geometry references the source geometry, which must
+ * outlive it.
+ */
+///@{
+
+/**
+ * Create a Prepared Geometry.
+ * \param g The base geometry to wrap in a prepared geometry.
+ * \return A prepared geometry. Caller is responsible for freeing with
+ *         GEOSPreparedGeom_destroy()
+ */
+extern const GEOSPreparedGeometry GEOS_DLL *GEOSPrepare(const GEOSGeometry *g);
+
+/**
+ * Free the memory associated with a \ref GEOSPreparedGeometry.
+ * Caller must separately free the base \ref GEOSGeometry used
+ * to create the prepared geometry.
+ * \param g Prepared geometry to destroy.
+ */
+extern void GEOS_DLL GEOSPreparedGeom_destroy(const GEOSPreparedGeometry *g);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the provided geometry is contained.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSContains
+ */
+extern char GEOS_DLL GEOSPreparedContains(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the point (x, y) is contained.
+ * \param pg1 The prepared geometry
+ * \param x The x coordinate of the point to test
+ * \param y The y coordinate of the point to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSContains
+ */
+extern char GEOS_DLL GEOSPreparedContainsXY(const GEOSPreparedGeometry *pg1, double x, double y);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is covered by the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedCoveredBy(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry covers the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedCovers(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is disjoint from the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSDisjoint
+ */
+extern char GEOS_DLL GEOSPreparedDisjoint(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry intersects the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSIntersects
+ */
+extern char GEOS_DLL GEOSPreparedIntersects(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry intersects the point (x, y).
+ * \param pg1 The prepared geometry
+ * \param x The x coordinate of the point to test
+ * \param y The y coordinate of the point to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ * \see GEOSIntersects
+ */
+extern char GEOS_DLL GEOSPreparedIntersectsXY(const GEOSPreparedGeometry *pg1, double x, double y);
+
+/**
+ * Using a \ref GEOSPreparedGeometry do a high performance
+ * calculation of whether the prepared geometry is within the provided geometry.
+ * \param pg1 The prepared geometry
+ * \param g2 The geometry to test
+ * \returns 1 on true, 0 on false, 2 on exception
+ */
+extern char GEOS_DLL GEOSPreparedWithin(const GEOSPreparedGeometry *pg1, const GEOSGeometry *g2);
+
+///@}
+
 #endif /* #ifndef GEOS_USE_ONLY_R_API */
 
 #ifdef __cplusplus
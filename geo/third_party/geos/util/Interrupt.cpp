@@ -16,8 +16,8 @@
 #include <geos/util/Interrupt.hpp>
 
 namespace {
-/* Could these be portably stored in thread-specific space ? */
-bool requested = false;
+/* Interruption requests are per thread, like the GEOS contexts */
+thread_local bool requested = false;
 
 geos::util::Interrupt::Callback *callback = nullptr;
 } // namespace
@@ -0,0 +1,157 @@
+#include "wkb-builder.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+//! Powers of ten that are exactly representable as a double
+static const double EXACT_POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool WKBBuilder::TryExactDouble(uint64_t mantissa, int exponent, double &result) {
+	if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+		return false;
+	}
+	/* Both operands are exact, so the single rounding of the product or quotient is the correct one */
+	double value = (double)mantissa;
+	result = exponent < 0 ? value / EXACT_POWERS_OF_TEN[-exponent] : value * EXACT_POWERS_OF_TEN[exponent];
+	return true;
+}
+
+void WKBBuilder::Reset() {
+	nodes.clear();
+	coords.clear();
+	srid = SRID_UNKNOWN;
+}
+
+idx_t WKBBuilder::AddNode(uint8_t type) {
+	Node node;
+	node.type = type;
+	node.has_z = false;
+	node.has_m = false;
+	node.empty = true;
+	node.count = 0;
+	node.coords = coords.size();
+	node.end = nodes.size() + 1;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+void WKBBuilder::SetDimensionality(idx_t node, bool has_z, bool has_m) {
+	for (idx_t i = node; i < nodes[node].end; i++) {
+		nodes[i].has_z = has_z;
+		nodes[i].has_m = has_m;
+	}
+}
+
+static uint32_t WKBTypeFromLWType(uint8_t type) {
+	switch (type) {
+	case POINTTYPE:
+		return WKB_POINT_TYPE;
+	case LINETYPE:
+		return WKB_LINESTRING_TYPE;
+	case POLYGONTYPE:
+		return WKB_POLYGON_TYPE;
+	case MULTIPOINTTYPE:
+		return WKB_MULTIPOINT_TYPE;
+	case MULTILINETYPE:
+		return WKB_MULTILINESTRING_TYPE;
+	case MULTIPOLYGONTYPE:
+		return WKB_MULTIPOLYGON_TYPE;
+	default:
+		return WKB_GEOMETRYCOLLECTION_TYPE;
+	}
+}
+
+idx_t WKBBuilder::NodeSize(idx_t node, bool with_srid) const {
+	auto &entry = nodes[node];
+	idx_t size = WKB_BYTE_SIZE + WKB_INT_SIZE + (with_srid ? WKB_INT_SIZE : 0);
+	idx_t point_size = (2 + entry.has_z + entry.has_m) * WKB_DOUBLE_SIZE;
+	switch (entry.type) {
+	case POINTTYPE:
+		/* POINT EMPTY is written as POINT(NaN NaN) */
+		return size + point_size;
+	case LINETYPE:
+		return size + WKB_INT_SIZE + entry.count * point_size;
+	case POLYGONTYPE:
+		size += WKB_INT_SIZE;
+		for (auto ring = node + 1; ring < entry.end; ring++) {
+			size += WKB_INT_SIZE + nodes[ring].count * point_size;
+		}
+		return size;
+	default:
+		size += WKB_INT_SIZE;
+		auto member = node + 1;
+		for (uint32_t i = 0; i < entry.count; i++, member = nodes[member].end) {
+			size += NodeSize(member, false);
+		}
+		return size;
+	}
+}
+
+static inline data_ptr_t WriteInteger(uint32_t value, data_ptr_t target) {
+	memcpy(target, &value, WKB_INT_SIZE);
+	return target + WKB_INT_SIZE;
+}
+
+data_ptr_t WKBBuilder::WriteNode(idx_t node, bool with_srid, data_ptr_t target) const {
+	/* Machine byte order and EWKB flags, as lwgeom_to_wkb writes with WKB_EXTENDED */
+	auto &entry = nodes[node];
+	uint32_t wkb_type = WKBTypeFromLWType(entry.type);
+	wkb_type |= entry.has_z ? WKBZOFFSET : 0;
+	wkb_type |= entry.has_m ? WKBMOFFSET : 0;
+	wkb_type |= with_srid ? WKBSRIDFLAG : 0;
+	*target = IS_BIG_ENDIAN ? 0 : 1;
+	target = WriteInteger(wkb_type, target + WKB_BYTE_SIZE);
+	if (with_srid) {
+		target = WriteInteger((uint32_t)srid, target);
+	}
+
+	idx_t ndims = 2 + entry.has_z + entry.has_m;
+	switch (entry.type) {
+	case POINTTYPE:
+		if (entry.empty) {
+			const uint64_t nan_bits = 0x7FF8000000000000ULL;
+			for (idx_t i = 0; i < ndims; i++) {
+				memcpy(target + i * WKB_DOUBLE_SIZE, &nan_bits, WKB_DOUBLE_SIZE);
+			}
+		} else {
+			memcpy(target, &coords[entry.coords], ndims * WKB_DOUBLE_SIZE);
+		}
+		return target + ndims * WKB_DOUBLE_SIZE;
+	case LINETYPE:
+		target = WriteInteger(entry.count, target);
+		if (entry.count > 0) {
+			memcpy(target, &coords[entry.coords], entry.count * ndims * WKB_DOUBLE_SIZE);
+		}
+		return target + entry.count * ndims * WKB_DOUBLE_SIZE;
+	case POLYGONTYPE:
+		target = WriteInteger(entry.count, target);
+		for (auto ring = node + 1; ring < entry.end; ring++) {
+			auto &ring_entry = nodes[ring];
+			target = WriteInteger(ring_entry.count, target);
+			memcpy(target, &coords[ring_entry.coords], ring_entry.count * ndims * WKB_DOUBLE_SIZE);
+			target += ring_entry.count * ndims * WKB_DOUBLE_SIZE;
+		}
+		return target;
+	default:
+		target = WriteInteger(entry.count, target);
+		auto member = node + 1;
+		for (uint32_t i = 0; i < entry.count; i++, member = nodes[member].end) {
+			target = WriteNode(member, false, target);
+		}
+		return target;
+	}
+}
+
+idx_t WKBBuilder::GetWKBSize() const {
+	return NodeSize(0, srid != SRID_UNKNOWN);
+}
+
+void WKBBuilder::WriteWKB(data_ptr_t target) const {
+	WriteNode(0, srid != SRID_UNKNOWN, target);
+}
+
+} // namespace duckdb
@@ -0,0 +1,414 @@
+#include "wkb-text-writer.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+static const char *WKTTypeName(uint8_t type) {
+	switch (type) {
+	case POINTTYPE:
+		return "POINT";
+	case LINETYPE:
+		return "LINESTRING";
+	case POLYGONTYPE:
+		return "POLYGON";
+	case MULTIPOINTTYPE:
+		return "MULTIPOINT";
+	case MULTILINETYPE:
+		return "MULTILINESTRING";
+	case MULTIPOLYGONTYPE:
+		return "MULTIPOLYGON";
+	default:
+		return "GEOMETRYCOLLECTION";
+	}
+}
+
+static const char *GeoJSONTypeName(uint8_t type) {
+	switch (type) {
+	case POINTTYPE:
+		return "Point";
+	case LINETYPE:
+		return "LineString";
+	case POLYGONTYPE:
+		return "Polygon";
+	case MULTIPOINTTYPE:
+		return "MultiPoint";
+	case MULTILINETYPE:
+		return "MultiLineString";
+	case MULTIPOLYGONTYPE:
+		return "MultiPolygon";
+	default:
+		return "GeometryCollection";
+	}
+}
+
+//! Read the header of a geometry, and check that the writers handle its type and that liblwgeom accepts it as a member
+//! of parent_type (0 at the top level). The liblwgeom numbers of the handled types are the ones up to COLLECTIONTYPE.
+static bool ReadSupportedHeader(WKBReader &reader, uint8_t parent_type, WKBGeometryHeader &header) {
+	return reader.ReadHeader(header) && header.type <= COLLECTIONTYPE &&
+	       (parent_type == 0 || lwcollection_allows_subtype(parent_type, header.type));
+}
+
+//! Whether the point at the cursor is POINT EMPTY, which WKB encodes as POINT(NaN NaN)
+static bool IsEmptyPoint(const WKBReader &reader, const WKBGeometryHeader &header) {
+	return std::isnan(WKBReader::LoadDouble(reader.pos, header.swap_bytes)) &&
+	       std::isnan(WKBReader::LoadDouble(reader.pos + WKB_DOUBLE_SIZE, header.swap_bytes));
+}
+
+void WKBTextWriter::Reserve(idx_t len) {
+	if (size + len > buffer.size()) {
+		buffer.resize(MaxValue<idx_t>(buffer.size() * 2, size + len));
+	}
+}
+
+void WKBTextWriter::Append(const char *str, idx_t len) {
+	Reserve(len);
+	memcpy(buffer.data() + size, str, len);
+	size += len;
+}
+
+void WKBTextWriter::Append(char c) {
+	Reserve(1);
+	buffer[size++] = c;
+}
+
+void WKBTextWriter::AppendDouble(double d, int precision) {
+	/* lwprint_double also writes a terminating NUL */
+	Reserve(OUT_DOUBLE_BUFFER_SIZE);
+	size += lwprint_double(d, precision, buffer.data() + size);
+}
+
+bool WKBTextWriter::TryWriteWKT(const WKBView &view, int precision) {
+	size = 0;
+	if (!view.IsValid()) {
+		return false;
+	}
+	WKBReader reader {view.GetData(), view.GetData() + view.GetSize(), false};
+	return WriteWKTGeometry(reader, 0, precision, 1);
+}
+
+void WKBTextWriter::WriteWKTEmpty() {
+	/* Same as empty_to_wkt_sb: pad with a space unless the text ends with a space, a comma or a paren */
+	if (size > 0 && !strchr(" ,(", buffer[size - 1])) {
+		Append(' ');
+	}
+	Append("EMPTY", 5);
+}
+
+bool WKBTextWriter::WriteWKTPointArray(WKBReader &reader, const WKBGeometryHeader &header, uint32_t npoints,
+                                       bool parens, int precision) {
+	auto point_size = header.PointSize();
+	if (npoints > reader.Remaining() / point_size) {
+		return false;
+	}
+	auto dimensions = point_size / WKB_DOUBLE_SIZE;
+	if (parens) {
+		Append('(');
+	}
+	for (uint32_t i = 0; i < npoints; i++) {
+		if (i > 0) {
+			Append(',');
+		}
+		for (idx_t d = 0; d < dimensions; d++) {
+			if (d > 0) {
+				Append(' ');
+			}
+			AppendDouble(WKBReader::LoadDouble(reader.pos + d * WKB_DOUBLE_SIZE, header.swap_bytes), precision);
+		}
+		reader.pos += point_size;
+	}
+	if (parens) {
+		Append(')');
+	}
+	return true;
+}
+
+bool WKBTextWriter::WriteWKTGeometry(WKBReader &reader, uint8_t parent_type, int precision, idx_t depth) {
+	WKBGeometryHeader header;
+	if (!ReadSupportedHeader(reader, parent_type, header)) {
+		return false;
+	}
+	/* Members of multi geometries have no type name, like WKT_NO_TYPE in lwout_wkt */
+	if (parent_type == 0 || parent_type == COLLECTIONTYPE) {
+		auto name = WKTTypeName(header.type);
+		Append(name, strlen(name));
+		/* Same as dimension_qualifiers_to_wkt_sb with WKT_ISO: POINT ZM (0 0 0 0) */
+		if (header.has_z || header.has_m) {
+			Append(' ');
+			if (header.has_z) {
+				Append('Z');
+			}
+			if (header.has_m) {
+				Append('M');
+			}
+			Append(' ');
+		}
+	}
+
+	switch (header.type) {
+	case POINTTYPE: {
+		if (reader.Remaining() < header.PointSize()) {
+			return false;
+		}
+		if (IsEmptyPoint(reader, header)) {
+			reader.pos += header.PointSize();
+			WriteWKTEmpty();
+			return true;
+		}
+		/* MULTIPOINT(0 0,1 1) does not wrap its points in parens */
+		return WriteWKTPointArray(reader, header, 1, parent_type != MULTIPOINTTYPE, precision);
+	}
+	case LINETYPE: {
+		uint32_t npoints;
+		if (!reader.ReadInteger(npoints)) {
+			return false;
+		}
+		if (npoints == 0) {
+			WriteWKTEmpty();
+			return true;
+		}
+		return WriteWKTPointArray(reader, header, npoints, true, precision);
+	}
+	case POLYGONTYPE: {
+		uint32_t nrings;
+		if (!reader.ReadInteger(nrings) || (nrings > 0 && reader.Remaining() < WKB_INT_SIZE)) {
+			return false;
+		}
+		/* Same as lwpoly_is_empty: no rings, or an empty shell */
+		if (nrings == 0 || WKBReader::LoadInteger(reader.pos, header.swap_bytes) == 0) {
+			WriteWKTEmpty();
+			for (uint32_t i = 0; i < nrings; i++) {
+				uint32_t npoints;
+				if (!reader.ReadInteger(npoints) || npoints > reader.Remaining() / header.PointSize()) {
+					return false;
+				}
+				reader.pos += npoints * header.PointSize();
+			}
+			return true;
+		}
+		Append('(');
+		for (uint32_t i = 0; i < nrings; i++) {
+			if (i > 0) {
+				Append(',');
+			}
+			uint32_t npoints;
+			if (!reader.ReadInteger(npoints) || !WriteWKTPointArray(reader, header, npoints, true, precision)) {
+				return false;
+			}
+		}
+		Append(')');
+		return true;
+	}
+	default: {
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		/* Collections print EMPTY only when they have no members, even if all of them are empty */
+		if (ngeoms == 0) {
+			WriteWKTEmpty();
+			return true;
+		}
+		if (depth + 1 >= WKB_VIEW_MAX_DEPTH) {
+			return false;
+		}
+		Append('(');
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			if (i > 0) {
+				Append(',');
+			}
+			if (!WriteWKTGeometry(reader, header.type, precision, depth + 1)) {
+				return false;
+			}
+		}
+		Append(')');
+		return true;
+	}
+	}
+}
+
+bool WKBTextWriter::TryWriteGeoJSON(const WKBView &view, int precision) {
+	size = 0;
+	if (!view.IsValid()) {
+		return false;
+	}
+	WKBReader reader {view.GetData(), view.GetData() + view.GetSize(), false};
+	return WriteGeoJSONGeometry(reader, false, precision);
+}
+
+bool WKBTextWriter::WriteGeoJSONPointArray(WKBReader &reader, const WKBGeometryHeader &header, uint32_t npoints,
+                                           int precision) {
+	auto point_size = header.PointSize();
+	if (npoints > reader.Remaining() / point_size) {
+		return false;
+	}
+	/* Same as pointArray_to_geojson: [x,y] or [x,y,z], M is dropped */
+	for (uint32_t i = 0; i < npoints; i++) {
+		if (i > 0) {
+			Append(',');
+		}
+		Append('[');
+		AppendDouble(WKBReader::LoadDouble(reader.pos, header.swap_bytes), precision);
+		Append(',');
+		AppendDouble(WKBReader::LoadDouble(reader.pos + WKB_DOUBLE_SIZE, header.swap_bytes), precision);
+		if (header.has_z) {
+			Append(',');
+			AppendDouble(WKBReader::LoadDouble(reader.pos + 2 * WKB_DOUBLE_SIZE, header.swap_bytes), precision);
+		}
+		Append(']');
+		reader.pos += point_size;
+	}
+	return true;
+}
+
+bool WKBTextWriter::WriteGeoJSONRings(WKBReader &reader, const WKBGeometryHeader &header, int precision) {
+	uint32_t nrings;
+	if (!reader.ReadInteger(nrings)) {
+		return false;
+	}
+	/* Unlike WKT, every ring is written, even when the shell is empty */
+	Append('[');
+	for (uint32_t i = 0; i < nrings; i++) {
+		if (i > 0) {
+			Append(',');
+		}
+		Append('[');
+		uint32_t npoints;
+		if (!reader.ReadInteger(npoints) || !WriteGeoJSONPointArray(reader, header, npoints, precision)) {
+			return false;
+		}
+		Append(']');
+	}
+	Append(']');
+	return true;
+}
+
+bool WKBTextWriter::WriteGeoJSONGeometry(WKBReader &reader, bool member, int precision) {
+	WKBGeometryHeader header;
+	if (!ReadSupportedHeader(reader, 0, header)) {
+		return false;
+	}
+	/* lwgeom_to_geojson raises an error for a collection inside a collection */
+	if (member && header.type == COLLECTIONTYPE) {
+		return false;
+	}
+	auto name = GeoJSONTypeName(header.type);
+	Append("{\"type\":\"", 9);
+	Append(name, strlen(name));
+	Append("\",", 2);
+
+	switch (header.type) {
+	case POINTTYPE: {
+		if (reader.Remaining() < header.PointSize()) {
+			return false;
+		}
+		Append("\"coordinates\":", 14);
+		if (IsEmptyPoint(reader, header)) {
+			reader.pos += header.PointSize();
+			Append("[]", 2);
+		} else if (!WriteGeoJSONPointArray(reader, header, 1, precision)) {
+			return false;
+		}
+		Append('}');
+		return true;
+	}
+	case LINETYPE: {
+		uint32_t npoints;
+		Append("\"coordinates\":[", 15);
+		if (!reader.ReadInteger(npoints) || !WriteGeoJSONPointArray(reader, header, npoints, precision)) {
+			return false;
+		}
+		Append("]}", 2);
+		return true;
+	}
+	case POLYGONTYPE: {
+		Append("\"coordinates\":", 14);
+		if (!WriteGeoJSONRings(reader, header, precision)) {
+			return false;
+		}
+		Append('}');
+		return true;
+	}
+	case COLLECTIONTYPE: {
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		Append("\"geometries\":[", 14);
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			if (i > 0) {
+				Append(',');
+			}
+			if (!WriteGeoJSONGeometry(reader, true, precision)) {
+				return false;
+			}
+		}
+		Append("]}", 2);
+		return true;
+	}
+	default: {
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		Append("\"coordinates\":[", 15);
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			if (i > 0) {
+				Append(',');
+			}
+			WKBGeometryHeader sub_header;
+			if (!ReadSupportedHeader(reader, header.type, sub_header)) {
+				return false;
+			}
+			switch (sub_header.type) {
+			case POINTTYPE:
+				if (reader.Remaining() < sub_header.PointSize()) {
+					return false;
+				}
+				/* An empty point has no position, which leaves an empty slot in the array */
+				if (IsEmptyPoint(reader, sub_header)) {
+					reader.pos += sub_header.PointSize();
+				} else if (!WriteGeoJSONPointArray(reader, sub_header, 1, precision)) {
+					return false;
+				}
+				break;
+			case LINETYPE: {
+				uint32_t npoints;
+				Append('[');
+				if (!reader.ReadInteger(npoints) || !WriteGeoJSONPointArray(reader, sub_header, npoints, precision)) {
+					return false;
+				}
+				Append(']');
+				break;
+			}
+			default:
+				if (!WriteGeoJSONRings(reader, sub_header, precision)) {
+					return false;
+				}
+				break;
+			}
+		}
+		Append("]}", 2);
+		return true;
+	}
+	}
+}
+
+bool WKBTextWriter::CanWriteHexWKB(const WKBView &view) {
+	/* GEOGRAPHY values are stored in machine byte order, the text is always NDR */
+	return !IS_BIG_ENDIAN && view.IsCanonical();
+}
+
+void WKBTextWriter::WriteHexWKB(const WKBView &view, char *target) {
+	static const char *hex_digits = "0123456789ABCDEF";
+	auto data = view.GetData();
+	for (idx_t i = 0; i < view.GetSize(); i++) {
+		target[2 * i] = hex_digits[data[i] >> 4];
+		target[2 * i + 1] = hex_digits[data[i] & 0x0F];
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,248 @@
+#include "wkb-validator.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+//! Size of one 2D vertex, the part of the first and last vertices of a ring compared by ptarray_is_closed_2d
+#define WKB_POINT2D_SIZE (2 * WKB_DOUBLE_SIZE)
+
+static inline data_ptr_t WriteInteger(uint32_t value, data_ptr_t target) {
+	memcpy(target, &value, WKB_INT_SIZE);
+	return target + WKB_INT_SIZE;
+}
+
+//! Copy count ordinates from source into target in machine byte order
+static data_ptr_t WriteDoubles(const_data_ptr_t source, idx_t count, bool swap_bytes, data_ptr_t target) {
+	if (!swap_bytes) {
+		memcpy(target, source, count * WKB_DOUBLE_SIZE);
+		return target + count * WKB_DOUBLE_SIZE;
+	}
+	for (idx_t i = 0; i < count; i++) {
+		/* Compilers turn this into a single byte swap instruction */
+		uint64_t value;
+		memcpy(&value, source, WKB_DOUBLE_SIZE);
+		value = ((value & 0x00000000000000FFULL) << 56) | ((value & 0x000000000000FF00ULL) << 40) |
+		        ((value & 0x0000000000FF0000ULL) << 24) | ((value & 0x00000000FF000000ULL) << 8) |
+		        ((value & 0x000000FF00000000ULL) >> 8) | ((value & 0x0000FF0000000000ULL) >> 24) |
+		        ((value & 0x00FF000000000000ULL) >> 40) | ((value & 0xFF00000000000000ULL) >> 56);
+		memcpy(target, &value, WKB_DOUBLE_SIZE);
+		source += WKB_DOUBLE_SIZE;
+		target += WKB_DOUBLE_SIZE;
+	}
+	return target;
+}
+
+//! Whether a point starting at ptr is POINT EMPTY, i.e. its X and Y are NaN (see lwpoint_from_wkb_state)
+static bool IsEmptyPoint(const_data_ptr_t ptr, bool swap_bytes) {
+	return std::isnan(WKBReader::LoadDouble(ptr, swap_bytes)) &&
+	       std::isnan(WKBReader::LoadDouble(ptr + WKB_DOUBLE_SIZE, swap_bytes));
+}
+
+bool WKBValidator::TryValidate(const_data_ptr_t data_p, idx_t size_p, int32_t srid_p) {
+	data = data_p;
+	size = size_p;
+	srid = srid_p;
+	canonical = true;
+	result_size = 0;
+	if (!data || size == 0) {
+		return false;
+	}
+	WKBReader reader {data, data + size, false};
+	if (!ValidateGeometry(reader, nullptr, 1)) {
+		return false;
+	}
+	/* lwgeom_from_wkb ignores trailing bytes */
+	if (reader.Remaining() > 0) {
+		canonical = false;
+	}
+	return true;
+}
+
+bool WKBValidator::ValidateGeometry(WKBReader &reader, const WKBGeometryHeader *parent, idx_t depth) {
+	auto start = reader.pos;
+	WKBGeometryHeader header;
+	if (!reader.ReadHeader(header)) {
+		return false;
+	}
+	/* The liblwgeom numbers of the types below are their WKB numbers */
+	if (header.type > COLLECTIONTYPE) {
+		return false;
+	}
+	/* Members must fit their collection, and have its dimensions or the GSERIALIZED cannot be written */
+	if (parent && (!lwcollection_allows_subtype(parent->type, header.type) || header.has_z != parent->has_z ||
+	               header.has_m != parent->has_m)) {
+		return false;
+	}
+
+	/* Only the outermost geometry keeps its SRID, which the srid argument overrides */
+	uint32_t wkb_type = header.type | (header.has_z ? WKBZOFFSET : 0) | (header.has_m ? WKBMOFFSET : 0);
+	result_size += WKB_BYTE_SIZE + WKB_INT_SIZE;
+	if (!parent) {
+		if (srid != SRID_UNKNOWN) {
+			srid = clamp_srid(srid);
+		} else {
+			srid = header.srid;
+		}
+		if (srid != SRID_UNKNOWN) {
+			wkb_type |= WKBSRIDFLAG;
+			result_size += WKB_INT_SIZE;
+			if (!header.has_srid || (int32_t)WKBReader::LoadInteger(start + WKB_BYTE_SIZE + WKB_INT_SIZE,
+			                                                         header.swap_bytes) != srid) {
+				canonical = false;
+			}
+		}
+	}
+	if (header.swap_bytes || WKBReader::LoadInteger(start + WKB_BYTE_SIZE, header.swap_bytes) != wkb_type) {
+		canonical = false;
+	}
+
+	auto point_size = header.PointSize();
+	switch (header.type) {
+	case POINTTYPE: {
+		if (reader.Remaining() < point_size) {
+			return false;
+		}
+		/* POINT EMPTY is stored with the NaN of double_nan_to_wkb_buf in every ordinate */
+		if (IsEmptyPoint(reader.pos, header.swap_bytes)) {
+			const uint64_t nan_bits = 0x7FF8000000000000ULL;
+			for (idx_t i = 0; i < point_size; i += WKB_DOUBLE_SIZE) {
+				if (memcmp(reader.pos + i, &nan_bits, WKB_DOUBLE_SIZE) != 0) {
+					canonical = false;
+				}
+			}
+		}
+		reader.pos += point_size;
+		result_size += point_size;
+		return true;
+	}
+	case LINETYPE: {
+		uint32_t npoints;
+		if (!reader.ReadInteger(npoints) || npoints > reader.Remaining() / point_size) {
+			return false;
+		}
+		/* LW_PARSER_CHECK_MINPOINTS */
+		if (npoints == 1) {
+			return false;
+		}
+		reader.pos += npoints * point_size;
+		result_size += WKB_INT_SIZE + npoints * point_size;
+		return true;
+	}
+	case POLYGONTYPE: {
+		uint32_t nrings;
+		if (!reader.ReadInteger(nrings)) {
+			return false;
+		}
+		result_size += WKB_INT_SIZE;
+		for (uint32_t i = 0; i < nrings; i++) {
+			uint32_t npoints;
+			if (!reader.ReadInteger(npoints) || npoints > reader.Remaining() / point_size) {
+				return false;
+			}
+			/* LW_PARSER_CHECK_MINPOINTS and LW_PARSER_CHECK_CLOSURE, which compares the bytes of the 2D vertices */
+			if (npoints < 4 ||
+			    memcmp(reader.pos, reader.pos + (npoints - 1) * point_size, WKB_POINT2D_SIZE) != 0) {
+				return false;
+			}
+			reader.pos += npoints * point_size;
+			result_size += WKB_INT_SIZE + npoints * point_size;
+		}
+		return true;
+	}
+	default: {
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		if (ngeoms > 0 && depth + 1 >= WKB_VIEW_MAX_DEPTH) {
+			return false;
+		}
+		result_size += WKB_INT_SIZE;
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			if (!ValidateGeometry(reader, &header, depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	}
+}
+
+void WKBValidator::Write(data_ptr_t target) const {
+	if (canonical) {
+		memcpy(target, data, result_size);
+		return;
+	}
+	WKBReader reader {data, data + size, false};
+	WriteGeometry(reader, true, target);
+}
+
+data_ptr_t WKBValidator::WriteGeometry(WKBReader &reader, bool top_level, data_ptr_t target) const {
+	/* The blob was validated, so the reads below cannot fail */
+	WKBGeometryHeader header;
+	reader.ReadHeader(header);
+
+	/* Machine byte order and EWKB flags, as lwgeom_to_wkb writes with WKB_EXTENDED */
+	bool with_srid = top_level && srid != SRID_UNKNOWN;
+	uint32_t wkb_type = header.type;
+	wkb_type |= header.has_z ? WKBZOFFSET : 0;
+	wkb_type |= header.has_m ? WKBMOFFSET : 0;
+	wkb_type |= with_srid ? WKBSRIDFLAG : 0;
+	*target = IS_BIG_ENDIAN ? 0 : 1;
+	target = WriteInteger(wkb_type, target + WKB_BYTE_SIZE);
+	if (with_srid) {
+		target = WriteInteger((uint32_t)srid, target);
+	}
+
+	idx_t ndims = 2 + header.has_z + header.has_m;
+	switch (header.type) {
+	case POINTTYPE:
+		if (IsEmptyPoint(reader.pos, header.swap_bytes)) {
+			const uint64_t nan_bits = 0x7FF8000000000000ULL;
+			for (idx_t i = 0; i < ndims; i++) {
+				memcpy(target + i * WKB_DOUBLE_SIZE, &nan_bits, WKB_DOUBLE_SIZE);
+			}
+			target += ndims * WKB_DOUBLE_SIZE;
+		} else {
+			target = WriteDoubles(reader.pos, ndims, header.swap_bytes, target);
+		}
+		reader.pos += ndims * WKB_DOUBLE_SIZE;
+		return target;
+	case LINETYPE: {
+		uint32_t npoints;
+		reader.ReadInteger(npoints);
+		target = WriteInteger(npoints, target);
+		target = WriteDoubles(reader.pos, npoints * ndims, header.swap_bytes, target);
+		reader.pos += npoints * ndims * WKB_DOUBLE_SIZE;
+		return target;
+	}
+	case POLYGONTYPE: {
+		uint32_t nrings;
+		reader.ReadInteger(nrings);
+		target = WriteInteger(nrings, target);
+		for (uint32_t i = 0; i < nrings; i++) {
+			uint32_t npoints;
+			reader.ReadInteger(npoints);
+			target = WriteInteger(npoints, target);
+			target = WriteDoubles(reader.pos, npoints * ndims, header.swap_bytes, target);
+			reader.pos += npoints * ndims * WKB_DOUBLE_SIZE;
+		}
+		return target;
+	}
+	default: {
+		uint32_t ngeoms;
+		reader.ReadInteger(ngeoms);
+		target = WriteInteger(ngeoms, target);
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			target = WriteGeometry(reader, false, target);
+		}
+		return target;
+	}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,724 @@
+#include "wkb-view.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+#include "wkb-reader.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace duckdb {
+
+//! Mirrors lwtype_from_wkb_state, returning 0 instead of raising an error for unknown type numbers
+static uint8_t LWTypeFromWKBType(uint32_t wkb_type, WKBGeometryHeader &header) {
+	header.has_z = false;
+	header.has_m = false;
+	header.has_srid = false;
+	if (wkb_type & 0xF0000000) {
+		header.has_z = wkb_type & WKBZOFFSET;
+		header.has_m = wkb_type & WKBMOFFSET;
+		header.has_srid = wkb_type & WKBSRIDFLAG;
+	}
+	wkb_type = wkb_type & 0x0FFFFFFF;
+	if (wkb_type >= 4000) {
+		return 0;
+	}
+	if (wkb_type >= 3000) {
+		header.has_z = true;
+		header.has_m = true;
+	} else if (wkb_type >= 2000) {
+		header.has_m = true;
+	} else if (wkb_type >= 1000) {
+		header.has_z = true;
+	}
+
+	switch (wkb_type % 1000) {
+	case WKB_POINT_TYPE:
+		return POINTTYPE;
+	case WKB_LINESTRING_TYPE:
+		return LINETYPE;
+	case WKB_POLYGON_TYPE:
+		return POLYGONTYPE;
+	case WKB_CIRCULARSTRING_TYPE:
+		return CIRCSTRINGTYPE;
+	case WKB_MULTIPOINT_TYPE:
+		return MULTIPOINTTYPE;
+	case WKB_MULTILINESTRING_TYPE:
+		return MULTILINETYPE;
+	case WKB_MULTIPOLYGON_TYPE:
+		return MULTIPOLYGONTYPE;
+	case WKB_TRIANGLE_TYPE:
+		return TRIANGLETYPE;
+	case WKB_GEOMETRYCOLLECTION_TYPE:
+		return COLLECTIONTYPE;
+	case WKB_COMPOUNDCURVE_TYPE:
+		return COMPOUNDTYPE;
+	case WKB_CURVEPOLYGON_TYPE:
+	case WKB_CURVE_TYPE:
+		return CURVEPOLYTYPE;
+	case WKB_MULTICURVE_TYPE:
+	case WKB_SURFACE_TYPE:
+		return MULTICURVETYPE;
+	case WKB_MULTISURFACE_TYPE:
+		return MULTISURFACETYPE;
+	case WKB_POLYHEDRALSURFACE_TYPE:
+		return POLYHEDRALSURFACETYPE;
+	case WKB_TIN_TYPE:
+		return TINTYPE;
+	default:
+		return 0;
+	}
+}
+
+bool WKBReader::ReadHeader(WKBGeometryHeader &header) {
+	uint8_t byte_order;
+	if (!ReadByte(byte_order) || (byte_order != 0 && byte_order != 1)) {
+		return false;
+	}
+	swap_bytes = IS_BIG_ENDIAN ? byte_order == 1 : byte_order == 0;
+	header.swap_bytes = swap_bytes;
+
+	uint32_t wkb_type;
+	if (!ReadInteger(wkb_type)) {
+		return false;
+	}
+	header.type = LWTypeFromWKBType(wkb_type, header);
+	if (header.type == 0) {
+		return false;
+	}
+
+	header.srid = SRID_UNKNOWN;
+	if (header.has_srid) {
+		uint32_t srid;
+		if (!ReadInteger(srid)) {
+			return false;
+		}
+		header.srid = clamp_srid((int32_t)srid);
+	}
+	return true;
+}
+
+//! What a scan over the geometry body should compute besides emptiness and the vertex count
+struct WKBScanState {
+	bool want_closure;
+	GBOX *box;
+};
+
+//! Per-geometry result of a scan
+struct WKBScanResult {
+	bool empty;
+	uint32_t npoints;
+	bool closed;
+	//! Same semantics as lwgeom_dimension, -1 if it depends on the shape (polyhedral surfaces)
+	int dimension;
+};
+
+//! Dimension of a geometry of the given type, -1 for the types whose dimension depends on their members or shape
+static int TypeDimension(uint8_t type) {
+	switch (type) {
+	case POINTTYPE:
+	case MULTIPOINTTYPE:
+		return 0;
+	case CIRCSTRINGTYPE:
+	case LINETYPE:
+	case COMPOUNDTYPE:
+	case MULTICURVETYPE:
+	case MULTILINETYPE:
+		return 1;
+	case TRIANGLETYPE:
+	case POLYGONTYPE:
+	case CURVEPOLYTYPE:
+	case MULTISURFACETYPE:
+	case MULTIPOLYGONTYPE:
+	case TINTYPE:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+static bool ScanPointArray(WKBReader &reader, const WKBGeometryHeader &header, WKBScanState &state,
+                           uint32_t &npoints, bool &closed) {
+	if (!reader.ReadInteger(npoints)) {
+		return false;
+	}
+	auto point_size = header.PointSize();
+	if (npoints > reader.Remaining() / point_size) {
+		return false;
+	}
+	auto points = reader.pos;
+	reader.pos += npoints * point_size;
+
+	if (state.want_closure) {
+		/* Same semantics as ptarray_is_closed_2d/3d: single points are closed, empty arrays are not */
+		auto compare_size = (header.has_z ? 3 : 2) * WKB_DOUBLE_SIZE;
+		closed = npoints <= 1 ? npoints == 1
+		                      : memcmp(points, points + (npoints - 1) * point_size, compare_size) == 0;
+	}
+	if (state.box) {
+		auto box = state.box;
+		for (uint32_t i = 0; i < npoints; i++) {
+			auto x = WKBReader::LoadDouble(points + i * point_size, header.swap_bytes);
+			auto y = WKBReader::LoadDouble(points + i * point_size + WKB_DOUBLE_SIZE, header.swap_bytes);
+			box->xmin = x < box->xmin ? x : box->xmin;
+			box->xmax = x > box->xmax ? x : box->xmax;
+			box->ymin = y < box->ymin ? y : box->ymin;
+			box->ymax = y > box->ymax ? y : box->ymax;
+		}
+	}
+	return true;
+}
+
+static bool ScanBody(WKBReader &reader, const WKBGeometryHeader &header, WKBScanState &state, WKBScanResult &result,
+                     idx_t depth) {
+	result.empty = true;
+	result.npoints = 0;
+	result.closed = false;
+	result.dimension = TypeDimension(header.type);
+
+	switch (header.type) {
+	case POINTTYPE: {
+		auto point_size = header.PointSize();
+		if (reader.Remaining() < point_size) {
+			return false;
+		}
+		auto x = WKBReader::LoadDouble(reader.pos, header.swap_bytes);
+		auto y = WKBReader::LoadDouble(reader.pos + WKB_DOUBLE_SIZE, header.swap_bytes);
+		reader.pos += point_size;
+		/* POINT(NaN NaN) is how WKB encodes POINT EMPTY */
+		if (std::isnan(x) && std::isnan(y)) {
+			return true;
+		}
+		result.empty = false;
+		result.npoints = 1;
+		result.closed = true;
+		if (state.box) {
+			state.box->xmin = x < state.box->xmin ? x : state.box->xmin;
+			state.box->xmax = x > state.box->xmax ? x : state.box->xmax;
+			state.box->ymin = y < state.box->ymin ? y : state.box->ymin;
+			state.box->ymax = y > state.box->ymax ? y : state.box->ymax;
+		}
+		return true;
+	}
+	case CIRCSTRINGTYPE:
+	case LINETYPE: {
+		if (header.type == CIRCSTRINGTYPE && state.box) {
+			/* Arcs can bulge out of the box of their vertices */
+			return false;
+		}
+		uint32_t npoints;
+		bool closed = false;
+		if (!ScanPointArray(reader, header, state, npoints, closed)) {
+			return false;
+		}
+		result.empty = npoints == 0;
+		result.npoints = npoints;
+		result.closed = !result.empty && closed;
+		return true;
+	}
+	case TRIANGLETYPE:
+	case POLYGONTYPE: {
+		uint32_t nrings;
+		if (!reader.ReadInteger(nrings)) {
+			return false;
+		}
+		if (header.type == TRIANGLETYPE && nrings > 1) {
+			return false;
+		}
+		bool all_closed = true;
+		for (uint32_t i = 0; i < nrings; i++) {
+			uint32_t npoints;
+			bool closed = false;
+			if (!ScanPointArray(reader, header, state, npoints, closed)) {
+				return false;
+			}
+			if (i == 0) {
+				result.empty = npoints == 0;
+			}
+			result.npoints += npoints;
+			all_closed = all_closed && closed;
+		}
+		if (result.empty) {
+			result.npoints = 0;
+			return true;
+		}
+		/* lwgeom_is_closed treats triangles like any other non-linear type */
+		result.closed = header.type == TRIANGLETYPE || all_closed;
+		return true;
+	}
+	case COMPOUNDTYPE:
+	case TINTYPE:
+	case POLYHEDRALSURFACETYPE:
+	case CURVEPOLYTYPE:
+	case MULTIPOINTTYPE:
+	case MULTILINETYPE:
+	case MULTIPOLYGONTYPE:
+	case MULTICURVETYPE:
+	case MULTISURFACETYPE:
+	case COLLECTIONTYPE: {
+		if (state.want_closure &&
+		    (header.type == COMPOUNDTYPE || header.type == TINTYPE || header.type == POLYHEDRALSURFACETYPE)) {
+			/* Closure of these types is defined over the whole shape, not per member */
+			return false;
+		}
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		if (ngeoms > 0 && depth + 1 >= WKB_VIEW_MAX_DEPTH) {
+			return false;
+		}
+		bool all_closed = true;
+		int max_dimension = 0;
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			WKBGeometryHeader sub_header;
+			WKBScanResult sub;
+			if (!reader.ReadHeader(sub_header) || !lwcollection_allows_subtype(header.type, sub_header.type) ||
+			    !ScanBody(reader, sub_header, state, sub, depth + 1)) {
+				return false;
+			}
+			result.empty = result.empty && sub.empty;
+			result.npoints += sub.npoints;
+			all_closed = all_closed && sub.closed;
+			if (sub.dimension < 0 || max_dimension < 0) {
+				max_dimension = -1;
+			} else if (sub.dimension > max_dimension) {
+				max_dimension = sub.dimension;
+			}
+		}
+		result.closed = !result.empty && all_closed;
+		if (header.type == COLLECTIONTYPE) {
+			result.dimension = max_dimension;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static bool ScanGeometry(WKBReader &reader, WKBScanState &state, WKBScanResult &result, idx_t depth) {
+	WKBGeometryHeader header;
+	if (!reader.ReadHeader(header)) {
+		return false;
+	}
+	return ScanBody(reader, header, state, result, depth);
+}
+
+//! Whether the ordinates at ptr are all the NaN lwgeom_to_wkb writes for POINT EMPTY
+static bool IsEmptyPointNaN(const_data_ptr_t ptr, idx_t count) {
+	/* 0x7FF8000000000000 in machine byte order, like double_nan_to_wkb_buf */
+	const uint64_t nan_bits = 0x7FF8000000000000ULL;
+	for (idx_t i = 0; i < count; i++) {
+		if (memcmp(ptr + i * WKB_DOUBLE_SIZE, &nan_bits, WKB_DOUBLE_SIZE) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Check that the bytes of a geometry are the ones lwgeom_to_wkb writes with WKB_EXTENDED after lwgeom_from_wkb read
+//! them
+static bool CheckCanonical(WKBReader &reader, uint8_t parent_type, idx_t depth) {
+	auto start = reader.pos;
+	WKBGeometryHeader header;
+	if (!reader.ReadHeader(header) || header.swap_bytes) {
+		return false;
+	}
+	/* The liblwgeom numbers of the types below are their WKB numbers */
+	if (header.type > COLLECTIONTYPE || (parent_type && !lwcollection_allows_subtype(parent_type, header.type))) {
+		return false;
+	}
+	/* Only the outermost geometry carries the SRID, and only when it is known */
+	bool top_level = parent_type == 0;
+	uint32_t wkb_type = header.type | (header.has_z ? WKBZOFFSET : 0) | (header.has_m ? WKBMOFFSET : 0);
+	if (top_level && header.srid != SRID_UNKNOWN) {
+		if ((int32_t)WKBReader::LoadInteger(start + WKB_BYTE_SIZE + WKB_INT_SIZE, false) != header.srid) {
+			return false;
+		}
+		wkb_type |= WKBSRIDFLAG;
+	}
+	if (WKBReader::LoadInteger(start + WKB_BYTE_SIZE, false) != wkb_type) {
+		return false;
+	}
+
+	auto point_size = header.PointSize();
+	switch (header.type) {
+	case POINTTYPE: {
+		if (reader.Remaining() < point_size) {
+			return false;
+		}
+		auto empty = std::isnan(WKBReader::LoadDouble(reader.pos, false)) &&
+		             std::isnan(WKBReader::LoadDouble(reader.pos + WKB_DOUBLE_SIZE, false));
+		if (empty && !IsEmptyPointNaN(reader.pos, point_size / WKB_DOUBLE_SIZE)) {
+			return false;
+		}
+		reader.pos += point_size;
+		return true;
+	}
+	case LINETYPE: {
+		uint32_t npoints;
+		if (!reader.ReadInteger(npoints) || npoints > reader.Remaining() / point_size) {
+			return false;
+		}
+		reader.pos += npoints * point_size;
+		return true;
+	}
+	case POLYGONTYPE: {
+		uint32_t nrings;
+		if (!reader.ReadInteger(nrings)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < nrings; i++) {
+			uint32_t npoints;
+			if (!reader.ReadInteger(npoints) || npoints > reader.Remaining() / point_size) {
+				return false;
+			}
+			/* A polygon whose shell is empty is written without rings */
+			if (i == 0 && npoints == 0) {
+				return false;
+			}
+			reader.pos += npoints * point_size;
+		}
+		return true;
+	}
+	default: {
+		uint32_t ngeoms;
+		if (!reader.ReadInteger(ngeoms)) {
+			return false;
+		}
+		if (ngeoms > 0 && depth + 1 >= WKB_VIEW_MAX_DEPTH) {
+			return false;
+		}
+		for (uint32_t i = 0; i < ngeoms; i++) {
+			if (!CheckCanonical(reader, header.type, depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	}
+}
+
+WKBView::WKBView(const_data_ptr_t data_p, idx_t size_p)
+    : data(data_p), size(size_p), body(0), type(0), swap_bytes(false), has_z(false), has_m(false), has_srid(false),
+      srid(SRID_UNKNOWN), has_cached_bbox(false) {
+	if (!data || size == 0) {
+		return;
+	}
+	if (data[0] == GEOGRAPHY_BBOX_MARKER) {
+		if (size < GEOGRAPHY_BBOX_PREFIX_SIZE || data[1] != GEOGRAPHY_BBOX_VERSION) {
+			return;
+		}
+		memset(&cached_bbox, 0, sizeof(GBOX));
+		cached_bbox.xmin = WKBReader::LoadDouble(data + 8, IS_BIG_ENDIAN);
+		cached_bbox.ymin = WKBReader::LoadDouble(data + 16, IS_BIG_ENDIAN);
+		cached_bbox.xmax = WKBReader::LoadDouble(data + 24, IS_BIG_ENDIAN);
+		cached_bbox.ymax = WKBReader::LoadDouble(data + 32, IS_BIG_ENDIAN);
+		has_cached_bbox = true;
+		data += GEOGRAPHY_BBOX_PREFIX_SIZE;
+		size -= GEOGRAPHY_BBOX_PREFIX_SIZE;
+		if (size == 0) {
+			return;
+		}
+	}
+	WKBReader reader {data, data + size, false};
+	WKBGeometryHeader header;
+	if (!reader.ReadHeader(header)) {
+		return;
+	}
+	body = reader.pos - data;
+	type = header.type;
+	swap_bytes = header.swap_bytes;
+	has_z = header.has_z;
+	has_m = header.has_m;
+	has_srid = header.has_srid;
+	srid = header.srid;
+}
+
+WKBView::WKBView(string_t blob) : WKBView((const_data_ptr_t)blob.GetDataUnsafe(), blob.GetSize()) {
+}
+
+static bool ScanView(const_data_ptr_t data, idx_t size, WKBScanState &state, WKBScanResult &result) {
+	WKBReader reader {data, data + size, false};
+	return ScanGeometry(reader, state, result, 1);
+}
+
+bool WKBView::IsCanonical() const {
+	if (!IsValid()) {
+		return false;
+	}
+	WKBReader reader {data, data + size, false};
+	return CheckCanonical(reader, 0, 1) && reader.Remaining() == 0;
+}
+
+bool WKBView::TryIsEmpty(bool &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	WKBScanState state {false, nullptr};
+	WKBScanResult scan;
+	if (!ScanView(data, size, state, scan)) {
+		return false;
+	}
+	result = scan.empty;
+	return true;
+}
+
+bool WKBView::TryNumPoints(uint32_t &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	WKBScanState state {false, nullptr};
+	WKBScanResult scan;
+	if (!ScanView(data, size, state, scan)) {
+		return false;
+	}
+	result = scan.npoints;
+	return true;
+}
+
+bool WKBView::TryIsClosed(bool &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	WKBScanState state {true, nullptr};
+	WKBScanResult scan;
+	if (!ScanView(data, size, state, scan)) {
+		return false;
+	}
+	result = scan.closed;
+	return true;
+}
+
+bool WKBView::TryNumGeometries(uint32_t &result) const {
+	bool is_empty;
+	if (!TryIsEmpty(is_empty)) {
+		return false;
+	}
+	if (is_empty) {
+		result = 0;
+		return true;
+	}
+	if (!lwtype_is_collection(type)) {
+		result = 1;
+		return true;
+	}
+	/* Every collection type, curve polygons included, starts its body with the member count */
+	WKBReader reader {data + body, data + size, swap_bytes};
+	return reader.ReadInteger(result);
+}
+
+bool WKBView::TryDimension(int &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	if (type != COLLECTIONTYPE) {
+		result = TypeDimension(type);
+		return result >= 0;
+	}
+	WKBScanState state {false, nullptr};
+	WKBScanResult scan;
+	if (!ScanView(data, size, state, scan) || scan.dimension < 0) {
+		return false;
+	}
+	result = scan.dimension;
+	return true;
+}
+
+bool WKBView::TryGetPoint(POINT4D &result) const {
+	if (type != POINTTYPE) {
+		return false;
+	}
+	auto point_size = (2 + has_z + has_m) * WKB_DOUBLE_SIZE;
+	if (size - body < point_size) {
+		return false;
+	}
+	auto ptr = data + body;
+	result.x = WKBReader::LoadDouble(ptr, swap_bytes);
+	result.y = WKBReader::LoadDouble(ptr + WKB_DOUBLE_SIZE, swap_bytes);
+	if (std::isnan(result.x) && std::isnan(result.y)) {
+		return false;
+	}
+	ptr += 2 * WKB_DOUBLE_SIZE;
+	result.z = has_z ? WKBReader::LoadDouble(ptr, swap_bytes) : 0.0;
+	ptr += has_z ? WKB_DOUBLE_SIZE : 0;
+	result.m = has_m ? WKBReader::LoadDouble(ptr, swap_bytes) : 0.0;
+	return true;
+}
+
+bool WKBView::TryGetStartPoint(POINT4D &result) const {
+	if (type != LINETYPE && type != CIRCSTRINGTYPE) {
+		return false;
+	}
+	WKBReader reader {data + body, data + size, swap_bytes};
+	uint32_t npoints;
+	auto point_size = (2 + has_z + has_m) * WKB_DOUBLE_SIZE;
+	if (!reader.ReadInteger(npoints) || npoints == 0 || npoints > reader.Remaining() / point_size) {
+		return false;
+	}
+	auto ptr = reader.pos;
+	result.x = WKBReader::LoadDouble(ptr, swap_bytes);
+	result.y = WKBReader::LoadDouble(ptr + WKB_DOUBLE_SIZE, swap_bytes);
+	ptr += 2 * WKB_DOUBLE_SIZE;
+	result.z = has_z ? WKBReader::LoadDouble(ptr, swap_bytes) : 0.0;
+	ptr += has_z ? WKB_DOUBLE_SIZE : 0;
+	result.m = has_m ? WKBReader::LoadDouble(ptr, swap_bytes) : 0.0;
+	return true;
+}
+
+bool WKBView::TryGetBBox(GBOX &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	if (has_cached_bbox) {
+		result = cached_bbox;
+		return true;
+	}
+	memset(&result, 0, sizeof(GBOX));
+	result.xmin = result.ymin = INFINITY;
+	result.xmax = result.ymax = -INFINITY;
+	WKBScanState state {false, &result};
+	WKBScanResult scan;
+	return ScanView(data, size, state, scan);
+}
+
+bool WKBView::TryIsRectangle(bool &result) const {
+	if (!IsValid()) {
+		return false;
+	}
+	result = false;
+	if (type != POLYGONTYPE) {
+		return true;
+	}
+	WKBReader reader {data + body, data + size, swap_bytes};
+	uint32_t nrings;
+	uint32_t npoints;
+	if (!reader.ReadInteger(nrings) || (nrings == 1 && !reader.ReadInteger(npoints))) {
+		return false;
+	}
+	if (nrings != 1 || npoints != 5) {
+		return true;
+	}
+	auto point_size = (2 + has_z + has_m) * WKB_DOUBLE_SIZE;
+	if (reader.Remaining() < 5 * point_size) {
+		return false;
+	}
+	double x[5];
+	double y[5];
+	for (idx_t i = 0; i < 5; i++) {
+		x[i] = WKBReader::LoadDouble(reader.pos + i * point_size, swap_bytes);
+		y[i] = WKBReader::LoadDouble(reader.pos + i * point_size + WKB_DOUBLE_SIZE, swap_bytes);
+	}
+	if (x[0] != x[4] || y[0] != y[4]) {
+		return true;
+	}
+	/* Four non-degenerate axis-aligned edges, alternating between horizontal and vertical */
+	for (idx_t i = 0; i < 4; i++) {
+		bool vertical = x[i] == x[i + 1];
+		bool horizontal = y[i] == y[i + 1];
+		if (vertical == horizontal) {
+			return true;
+		}
+		if (i > 0 && vertical == (x[i - 1] == x[i])) {
+			return true;
+		}
+	}
+	result = true;
+	return true;
+}
+
+bool WKBView::BinaryEquals(const WKBView &lhs, const WKBView &rhs) {
+	return lhs.size == rhs.size && memcmp(lhs.data, rhs.data, lhs.size) == 0;
+}
+
+void WKBView::WriteBBoxPrefix(const GBOX &box, data_ptr_t target) {
+	memset(target, 0, GEOGRAPHY_BBOX_PREFIX_SIZE);
+	target[0] = GEOGRAPHY_BBOX_MARKER;
+	target[1] = GEOGRAPHY_BBOX_VERSION;
+	const double values[] = {box.xmin, box.ymin, box.xmax, box.ymax};
+	for (idx_t i = 0; i < 4; i++) {
+		double value = WKBReader::LoadDouble((const_data_ptr_t)&values[i], IS_BIG_ENDIAN);
+		memcpy(target + 8 + i * WKB_DOUBLE_SIZE, &value, WKB_DOUBLE_SIZE);
+	}
+}
+
+idx_t WKBView::PointSize(bool has_z, bool has_m, int32_t srid) {
+	return WKB_BYTE_SIZE + WKB_INT_SIZE + (srid != SRID_UNKNOWN ? WKB_INT_SIZE : 0) +
+	       (2 + has_z + has_m) * WKB_DOUBLE_SIZE;
+}
+
+void WKBView::WritePoint(const POINT4D &point, bool has_z, bool has_m, int32_t srid, data_ptr_t target) {
+	/* Machine byte order and EWKB flags, as lwgeom_to_wkb writes with WKB_EXTENDED */
+	uint32_t wkb_type = WKB_POINT_TYPE;
+	wkb_type |= has_z ? WKBZOFFSET : 0;
+	wkb_type |= has_m ? WKBMOFFSET : 0;
+	wkb_type |= srid != SRID_UNKNOWN ? WKBSRIDFLAG : 0;
+	target[0] = IS_BIG_ENDIAN ? 0 : 1;
+	target += WKB_BYTE_SIZE;
+	memcpy(target, &wkb_type, WKB_INT_SIZE);
+	target += WKB_INT_SIZE;
+	if (srid != SRID_UNKNOWN) {
+		memcpy(target, &srid, WKB_INT_SIZE);
+		target += WKB_INT_SIZE;
+	}
+	memcpy(target, &point.x, WKB_DOUBLE_SIZE);
+	memcpy(target + WKB_DOUBLE_SIZE, &point.y, WKB_DOUBLE_SIZE);
+	target += 2 * WKB_DOUBLE_SIZE;
+	if (has_z) {
+		memcpy(target, &point.z, WKB_DOUBLE_SIZE);
+		target += WKB_DOUBLE_SIZE;
+	}
+	if (has_m) {
+		memcpy(target, &point.m, WKB_DOUBLE_SIZE);
+	}
+}
+
+void WKBView::WritePoint(double x, double y, data_ptr_t target) {
+	POINT4D point {x, y, 0.0, 0.0};
+	WritePoint(point, false, false, SRID_UNKNOWN, target);
+}
+
+void WKBView::WritePoint(double x, double y, double z, data_ptr_t target) {
+	POINT4D point {x, y, z, 0.0};
+	WritePoint(point, true, false, SRID_UNKNOWN, target);
+}
+
+idx_t WKBView::EnvelopeSize(const GBOX &box) {
+	bool flat_x = box.xmin == box.xmax;
+	bool flat_y = box.ymin == box.ymax;
+	if (flat_x && flat_y) {
+		return GEOGRAPHY_POINT_SIZE;
+	}
+	idx_t npoints = flat_x || flat_y ? 2 : 5;
+	idx_t nrings = flat_x || flat_y ? 0 : 1;
+	return WKB_BYTE_SIZE + WKB_INT_SIZE + nrings * WKB_INT_SIZE + WKB_INT_SIZE + npoints * 2 * WKB_DOUBLE_SIZE;
+}
+
+void WKBView::WriteEnvelope(const GBOX &box, data_ptr_t target) {
+	bool flat_x = box.xmin == box.xmax;
+	bool flat_y = box.ymin == box.ymax;
+	if (flat_x && flat_y) {
+		WritePoint(box.xmin, box.ymin, target);
+		return;
+	}
+	const double line[] = {box.xmin, box.ymin, box.xmax, box.ymax};
+	const double ring[] = {box.xmin, box.ymin, box.xmin, box.ymax, box.xmax, box.ymax,
+	                       box.xmax, box.ymin, box.xmin, box.ymin};
+	bool is_polygon = !flat_x && !flat_y;
+	uint32_t wkb_type = is_polygon ? WKB_POLYGON_TYPE : WKB_LINESTRING_TYPE;
+	uint32_t npoints = is_polygon ? 5 : 2;
+	target[0] = IS_BIG_ENDIAN ? 0 : 1;
+	target += WKB_BYTE_SIZE;
+	memcpy(target, &wkb_type, WKB_INT_SIZE);
+	target += WKB_INT_SIZE;
+	if (is_polygon) {
+		uint32_t nrings = 1;
+		memcpy(target, &nrings, WKB_INT_SIZE);
+		target += WKB_INT_SIZE;
+	}
+	memcpy(target, &npoints, WKB_INT_SIZE);
+	target += WKB_INT_SIZE;
+	memcpy(target, is_polygon ? ring : line, npoints * 2 * WKB_DOUBLE_SIZE);
+}
+
+} // namespace duckdb
@@ -0,0 +1,436 @@
+#include "wkt-reader.hpp"
+
+#include "liblwgeom/liblwgeom_internal.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace duckdb {
+
+//! Max nesting of collections, matches LW_PARSER_MAX_DEPTH of the WKB parser
+#define WKT_READER_MAX_DEPTH 200
+
+static inline bool IsDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline bool IsWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+//! The characters the lexer requires after a number
+static inline bool IsNumberDelimiter(char c) {
+	return IsWhitespace(c) || c == ',' || c == ')';
+}
+
+void WKTReader::SkipWhitespace() {
+	while (pos < end && IsWhitespace(*pos)) {
+		pos++;
+	}
+}
+
+bool WKTReader::Consume(char c) {
+	SkipWhitespace();
+	if (pos < end && *pos == c) {
+		pos++;
+		return true;
+	}
+	return false;
+}
+
+bool WKTReader::ConsumeKeyword(const char *keyword, idx_t len) {
+	SkipWhitespace();
+	/* Keywords are upper case only and need no separator, as in the flex lexer */
+	if ((idx_t)(end - pos) >= len && memcmp(pos, keyword, len) == 0) {
+		pos += len;
+		return true;
+	}
+	return false;
+}
+
+/*
+ * Same syntax as the DOUBLE token of the lexer: -?(([0-9]+\.?)|([0-9]*\.?[0-9]+)([eE][-+]?[0-9]+)?) followed by a
+ * space, a comma or a closing bracket. Values with at most 19 significant digits and a small decimal exponent are
+ * computed exactly (Clinger's fast path), the rest goes through strtod; both are correctly rounded, so the result
+ * always equals the atof of the lexer.
+ */
+bool WKTReader::ReadDouble(double &result) {
+	SkipWhitespace();
+	auto start = pos;
+	auto p = pos;
+	bool negative = false;
+	if (p < end && *p == '-') {
+		negative = true;
+		p++;
+	}
+
+	uint64_t mantissa = 0;
+	int significant_digits = 0;
+	int exponent = 0;
+	bool exact = true;
+	idx_t integer_digits = 0;
+	for (; p < end && IsDigit(*p); p++, integer_digits++) {
+		auto digit = *p - '0';
+		if (mantissa == 0 && digit == 0) {
+			continue;
+		}
+		if (significant_digits == 19) {
+			exact = false;
+			continue;
+		}
+		mantissa = mantissa * 10 + digit;
+		significant_digits++;
+	}
+	bool has_dot = false;
+	idx_t fraction_digits = 0;
+	if (p < end && *p == '.') {
+		has_dot = true;
+		for (p++; p < end && IsDigit(*p); p++, fraction_digits++) {
+			auto digit = *p - '0';
+			if (mantissa == 0 && digit == 0) {
+				exponent--;
+				continue;
+			}
+			if (significant_digits == 19) {
+				exact = false;
+				continue;
+			}
+			mantissa = mantissa * 10 + digit;
+			significant_digits++;
+			exponent--;
+		}
+	}
+	if (integer_digits + fraction_digits == 0) {
+		return false;
+	}
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		/* "1.e5" does not match the token */
+		if (has_dot && fraction_digits == 0) {
+			return false;
+		}
+		p++;
+		bool negative_exponent = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative_exponent = *p == '-';
+			p++;
+		}
+		if (p == end || !IsDigit(*p)) {
+			return false;
+		}
+		int explicit_exponent = 0;
+		for (; p < end && IsDigit(*p); p++) {
+			if (explicit_exponent < 10000) {
+				explicit_exponent = explicit_exponent * 10 + (*p - '0');
+			}
+		}
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+	}
+	if (p == end || !IsNumberDelimiter(*p)) {
+		return false;
+	}
+	pos = p;
+
+	double value;
+	if (exact && WKBBuilder::TryExactDouble(mantissa, exponent, value)) {
+		result = negative ? -value : value;
+	} else {
+		/* The delimiter stops strtod before the end of the text */
+		result = strtod(start, nullptr);
+	}
+	return true;
+}
+
+bool WKTReader::ReadCoordinate(int &ndims) {
+	double value;
+	for (ndims = 0; ndims < 4; ndims++) {
+		if (ndims >= 2) {
+			SkipWhitespace();
+			if (pos == end || !(IsDigit(*pos) || *pos == '-' || *pos == '.')) {
+				break;
+			}
+		}
+		if (!ReadDouble(value)) {
+			return false;
+		}
+		builder.coords.push_back(value);
+	}
+	return true;
+}
+
+bool WKTReader::ReadDimensionality(bool &has_z, bool &has_m) {
+	SkipWhitespace();
+	has_z = false;
+	has_m = false;
+	if (pos < end && *pos == 'Z') {
+		has_z = true;
+		pos++;
+		if (pos < end && *pos == 'M') {
+			has_m = true;
+			pos++;
+		}
+	} else if (pos < end && *pos == 'M') {
+		has_m = true;
+		pos++;
+	}
+	return has_z || has_m;
+}
+
+/*
+ * Reconcile the number of ordinates read with the Z/M tag, as wkt_pointarray_dimensionality does: a tag must match
+ * the ordinate count and decides between XYZ and XYM, without a tag the third ordinate is Z.
+ */
+bool WKTReader::ApplyDimensionality(idx_t node, int ndims, bool tagged) {
+	auto &entry = builder.nodes[node];
+	if (tagged) {
+		return 2 + entry.has_z + entry.has_m == ndims;
+	}
+	entry.has_z = ndims > 2;
+	entry.has_m = ndims > 3;
+	return true;
+}
+
+bool WKTReader::ReadPointArray(idx_t node, int &ndims) {
+	if (!Consume('(')) {
+		return false;
+	}
+	uint32_t npoints = 0;
+	do {
+		int point_ndims;
+		if (!ReadCoordinate(point_ndims)) {
+			return false;
+		}
+		if (npoints > 0 && point_ndims != ndims) {
+			return false;
+		}
+		ndims = point_ndims;
+		npoints++;
+	} while (Consume(','));
+	if (!Consume(')')) {
+		return false;
+	}
+	builder.nodes[node].count = npoints;
+	builder.nodes[node].empty = false;
+	return true;
+}
+
+bool WKTReader::ReadPointText(idx_t node, bool tagged, bool member) {
+	if (ConsumeKeyword("EMPTY", 5)) {
+		return true;
+	}
+	int ndims;
+	if (Consume('(')) {
+		if (!ReadCoordinate(ndims) || !Consume(')')) {
+			return false;
+		}
+	} else if (!member || !ReadCoordinate(ndims)) {
+		/* Only the members of a MULTIPOINT may omit the brackets */
+		return false;
+	}
+	builder.nodes[node].count = 1;
+	builder.nodes[node].empty = false;
+	return ApplyDimensionality(node, ndims, tagged);
+}
+
+bool WKTReader::ReadLineStringText(idx_t node, bool tagged) {
+	if (ConsumeKeyword("EMPTY", 5)) {
+		return true;
+	}
+	int ndims = 0;
+	if (!ReadPointArray(node, ndims)) {
+		return false;
+	}
+	/* LW_PARSER_CHECK_MINPOINTS */
+	if (builder.nodes[node].count < 2) {
+		return false;
+	}
+	return ApplyDimensionality(node, ndims, tagged);
+}
+
+bool WKTReader::ReadPolygonText(idx_t node, bool tagged) {
+	if (ConsumeKeyword("EMPTY", 5)) {
+		return true;
+	}
+	if (!Consume('(')) {
+		return false;
+	}
+	int ndims = 0;
+	uint32_t nrings = 0;
+	do {
+		auto ring = builder.AddNode(0);
+		int ring_ndims = 0;
+		if (!ReadPointArray(ring, ring_ndims)) {
+			return false;
+		}
+		if (nrings > 0 && ring_ndims != ndims) {
+			return false;
+		}
+		ndims = ring_ndims;
+		/* LW_PARSER_CHECK_MINPOINTS and LW_PARSER_CHECK_CLOSURE, with the same 2D memcmp as ptarray_is_closed_2d */
+		auto npoints = builder.nodes[ring].count;
+		if (npoints < 4) {
+			return false;
+		}
+		auto first = &builder.coords[builder.nodes[ring].coords];
+		auto last = first + (npoints - 1) * ndims;
+		if (memcmp(first, last, 2 * sizeof(double)) != 0) {
+			return false;
+		}
+		nrings++;
+	} while (Consume(','));
+	if (!Consume(')')) {
+		return false;
+	}
+	builder.nodes[node].count = nrings;
+	builder.nodes[node].empty = false;
+	builder.nodes[node].end = builder.nodes.size();
+	if (!ApplyDimensionality(node, ndims, tagged)) {
+		return false;
+	}
+	builder.SetDimensionality(node, builder.nodes[node].has_z, builder.nodes[node].has_m);
+	return true;
+}
+
+bool WKTReader::ReadCollectionText(idx_t node, uint8_t type, bool tagged, idx_t depth) {
+	if (ConsumeKeyword("EMPTY", 5)) {
+		return true;
+	}
+	if (!Consume('(')) {
+		return false;
+	}
+	uint32_t ngeoms = 0;
+	do {
+		bool success;
+		if (type == COLLECTIONTYPE) {
+			success = ReadGeometry(depth + 1);
+		} else {
+			auto member = builder.AddNode(type == MULTIPOINTTYPE  ? POINTTYPE
+			                      : type == MULTILINETYPE ? LINETYPE
+			                                              : POLYGONTYPE);
+			success = type == MULTIPOINTTYPE  ? ReadPointText(member, false, true)
+			          : type == MULTILINETYPE ? ReadLineStringText(member, false)
+			                                  : ReadPolygonText(member, false);
+		}
+		if (!success) {
+			return false;
+		}
+		ngeoms++;
+	} while (Consume(','));
+	if (!Consume(')')) {
+		return false;
+	}
+
+	auto &collection = builder.nodes[node];
+	collection.count = ngeoms;
+	collection.end = builder.nodes.size();
+	auto first = node + 1;
+	for (auto member = first; member < collection.end; member = builder.nodes[member].end) {
+		collection.empty = collection.empty && builder.nodes[member].empty;
+	}
+	if (tagged) {
+		/* Same checks as wkt_parser_collection_finalize, then every member takes the dimensions of the tag */
+		int ndims = 2 + collection.has_z + collection.has_m;
+		for (auto member = first; member < collection.end; member = builder.nodes[member].end) {
+			auto &entry = builder.nodes[member];
+			if (entry.empty) {
+				continue;
+			}
+			if (2 + entry.has_z + entry.has_m != ndims) {
+				return false;
+			}
+			if (type == COLLECTIONTYPE && (entry.has_z != collection.has_z || entry.has_m != collection.has_m)) {
+				return false;
+			}
+		}
+		builder.SetDimensionality(node, collection.has_z, collection.has_m);
+		return true;
+	}
+	/* liblwgeom takes the dimensions of the first member; mixed dimensions are left to it */
+	for (auto member = first; member < collection.end; member = builder.nodes[member].end) {
+		auto &entry = builder.nodes[member];
+		if (entry.has_z != builder.nodes[first].has_z || entry.has_m != builder.nodes[first].has_m) {
+			return false;
+		}
+	}
+	collection.has_z = builder.nodes[first].has_z;
+	collection.has_m = builder.nodes[first].has_m;
+	return true;
+}
+
+bool WKTReader::ReadGeometry(idx_t depth) {
+	if (depth > WKT_READER_MAX_DEPTH) {
+		return false;
+	}
+	uint8_t type;
+	if (ConsumeKeyword("POINT", 5)) {
+		type = POINTTYPE;
+	} else if (ConsumeKeyword("LINESTRING", 10)) {
+		type = LINETYPE;
+	} else if (ConsumeKeyword("POLYGON", 7)) {
+		type = POLYGONTYPE;
+	} else if (ConsumeKeyword("MULTIPOINT", 10)) {
+		type = MULTIPOINTTYPE;
+	} else if (ConsumeKeyword("MULTILINESTRING", 15)) {
+		type = MULTILINETYPE;
+	} else if (ConsumeKeyword("MULTIPOLYGON", 12)) {
+		type = MULTIPOLYGONTYPE;
+	} else if (ConsumeKeyword("GEOMETRYCOLLECTION", 18)) {
+		type = COLLECTIONTYPE;
+	} else {
+		/* Curves, triangles, TINs and polyhedral surfaces are left to liblwgeom */
+		return false;
+	}
+	auto node = builder.AddNode(type);
+	bool has_z, has_m;
+	bool tagged = ReadDimensionality(has_z, has_m);
+	builder.nodes[node].has_z = has_z;
+	builder.nodes[node].has_m = has_m;
+	switch (type) {
+	case POINTTYPE:
+		return ReadPointText(node, tagged, false);
+	case LINETYPE:
+		return ReadLineStringText(node, tagged);
+	case POLYGONTYPE:
+		return ReadPolygonText(node, tagged);
+	default:
+		return ReadCollectionText(node, type, tagged, depth);
+	}
+}
+
+bool WKTReader::TryRead(const char *text, idx_t len) {
+	pos = text;
+	end = text + len;
+	builder.Reset();
+
+	SkipWhitespace();
+	if (end - pos >= 5 && memcmp(pos, "SRID=", 5) == 0) {
+		auto digits = pos + 5;
+		auto p = digits;
+		if (p < end && *p == '-') {
+			p++;
+		}
+		auto first_digit = p;
+		while (p < end && IsDigit(*p)) {
+			p++;
+		}
+		if (p == first_digit || p == end) {
+			return false;
+		}
+		/* Same conversion as wkt_lexer_read_srid and wkt_parser_geometry_new; the digits are followed by a
+		 * non-digit, so strtol stays within the text */
+		builder.srid = clamp_srid((int32_t)strtol(digits, nullptr, 10));
+		if (builder.srid > SRID_MAXIMUM) {
+			builder.srid = SRID_UNKNOWN;
+		}
+		pos = p;
+		if (!Consume(';')) {
+			return false;
+		}
+	}
+	if (!ReadGeometry(0)) {
+		return false;
+	}
+	SkipWhitespace();
+	return pos == end;
+}
+
+} // namespace duckdb